@@ -0,0 +1,109 @@
+// Includes
+# include "AssetStreamer.hpp"
+# include <iostream>
+# include <algorithm>
+# include <SDL2/SDL_image.h>
+
+// AssetStreamer Functions
+AssetStreamer::~AssetStreamer() { stop(); }
+void AssetStreamer::start(int threads) {
+    if (!workers.empty()) return;
+
+    if (threads <= 0) threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency())) - 1;
+
+    stopping = false;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(&AssetStreamer::workerLoop, this);
+}
+void AssetStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+    workers.clear();
+
+    for (auto& d : decoded) SDL_FreeSurface(d.surface);
+    decoded.clear();
+    for (auto& pair : assets) SDL_DestroyTexture(pair.second.texture);
+    assets.clear();
+    pending = 0;
+}
+void AssetStreamer::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        // Decode and convert here so upload() is only the texture copy
+        SDL_Surface* surface = nullptr;
+        SDL_Surface* loaded = IMG_Load(job.path.c_str());
+        if (loaded) {
+            surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+            SDL_FreeSurface(loaded);
+        } else {
+            std::cerr << "Failed to load texture: " << job.path << " | Error: " << IMG_GetError() << "\n";
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            SDL_FreeSurface(surface);
+            return;
+        }
+        decoded.push_back({ job.key, surface });
+    }
+}
+AssetStreamer::State AssetStreamer::request(long long key, const std::string& path) {
+    Asset& asset = assets[key];
+    if (asset.state != State::Missing) return asset.state;
+
+    asset.state = State::Pending;
+    pending++;
+    if (workers.empty()) start();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({ key, path });
+    }
+    wake.notify_one();
+    return asset.state;
+}
+SDL_Texture* AssetStreamer::find(long long key) const {
+    auto it = assets.find(key);
+    return it == assets.end() ? nullptr : it->second.texture;
+}
+int AssetStreamer::upload(SDL_Renderer* renderer, double budgetMs) {
+    if (pending == 0) return 0;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = static_cast<Uint64>(budgetMs * SDL_GetPerformanceFrequency() / 1000.0);
+    int uploaded = 0;
+
+    for (;;) {
+        Decoded done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (decoded.empty()) break;
+            done = decoded.front();
+            decoded.pop_front();
+        }
+
+        Asset& asset = assets[done.key];
+        asset.texture = done.surface ? SDL_CreateTextureFromSurface(renderer, done.surface) : nullptr;
+        asset.state = asset.texture ? State::Ready : State::Failed;
+        SDL_FreeSurface(done.surface);
+        pending--;
+        uploaded++;
+
+        if (SDL_GetPerformanceCounter() - start >= budget) break; // The rest wait for the next frame
+    }
+
+    return uploaded;
+}
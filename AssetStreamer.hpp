@@ -0,0 +1,63 @@
+# ifndef ASSETSTREAMER_HPP
+# define ASSETSTREAMER_HPP
+
+# include <string>
+# include <vector>
+# include <deque>
+# include <unordered_map>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <SDL2/SDL.h>
+
+// Loads images off the render thread. Workers IMG_Load and convert into surfaces, the main thread
+// turns finished surfaces into textures in upload() under a time budget, since textures can only be made there.
+// request() and find() are main thread only; a key is requested once no matter how often it's asked for.
+
+// Classes
+class AssetStreamer {
+    public:
+        enum class State { Missing, Pending, Ready, Failed };
+
+        AssetStreamer() = default;
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+        ~AssetStreamer();
+
+        void start(int threads = 0); // 0 = hardware threads - 1, at least one
+        void stop(); // Joins workers and destroys every texture
+
+        State request(long long key, const std::string& path);
+        SDL_Texture* find(long long key) const; // nullptr until Ready
+        int upload(SDL_Renderer* renderer, double budgetMs); // Returns how many textures were created, always at least one if any are waiting
+
+        size_t pendingCount() const { return pending; }
+
+    private:
+        struct Job {
+            long long key;
+            std::string path;
+        };
+        struct Decoded {
+            long long key;
+            SDL_Surface* surface; // nullptr when the load failed
+        };
+        struct Asset {
+            State state = State::Missing;
+            SDL_Texture* texture = nullptr;
+        };
+
+        void workerLoop();
+
+        std::unordered_map<long long, Asset> assets;
+        size_t pending = 0;
+
+        std::mutex mutex; // Guards jobs, decoded and stopping
+        std::condition_variable wake;
+        std::deque<Job> jobs;
+        std::deque<Decoded> decoded;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+};
+
+# endif
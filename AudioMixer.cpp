@@ -0,0 +1,173 @@
+// Includes
+# include "AudioMixer.hpp"
+# include <iostream>
+# include <algorithm>
+# include <cstring>
+
+// AudioMixer Functions
+AudioMixer::~AudioMixer() { shutdown(); }
+bool AudioMixer::init(int requestedFrequency) {
+    if (device) return true;
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+        std::cerr << "SDL audio initialization failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    // Float stereo in, SDL converts if the hardware wants something else; a small buffer keeps latency down.
+    // The device may pick its own period instead, mix() takes whatever frame count the callback asks for
+    SDL_AudioSpec desired{};
+    desired.freq = requestedFrequency;
+    desired.format = AUDIO_F32SYS;
+    desired.channels = 2;
+    desired.samples = BufferFrames;
+    desired.callback = audioCallback;
+    desired.userdata = this;
+
+    SDL_AudioSpec obtained{};
+    device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (!device) {
+        std::cerr << "SDL_OpenAudioDevice failed: " << SDL_GetError() << "\n";
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+
+    frequency = obtained.freq;
+    bufferFrames = obtained.samples; // The hardware period, not SDL rebuffering to our size
+    return true;
+}
+bool AudioMixer::loadGameSounds() {
+    const char* paths[] = { "audio/swing.wav", "audio/hit.wav", "audio/walk.wav" };
+    static_assert(sizeof(paths) / sizeof(paths[0]) == static_cast<size_t>(SoundEffect::Count), "One file per SoundEffect");
+
+    bool ok = true;
+    for (int i = 0; i < static_cast<int>(SoundEffect::Count); ++i) {
+        if (loadSound(paths[i]) != i) ok = false; // Ids have to line up with SoundEffect
+    }
+    return ok;
+}
+int AudioMixer::loadSound(const std::string& path) {
+    if (!device) return -1;
+
+    SDL_AudioSpec spec;
+    Uint8* wav = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(path.c_str(), &spec, &wav, &length)) {
+        std::cerr << "Failed to load sound: " << path << " | Error: " << SDL_GetError() << "\n";
+        return -1;
+    }
+
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_F32SYS, 2, frequency) < 0) {
+        std::cerr << "Can't convert sound: " << path << " | Error: " << SDL_GetError() << "\n";
+        SDL_FreeWAV(wav);
+        return -1;
+    }
+
+    std::vector<Uint8> buffer(static_cast<size_t>(length) * std::max(1, cvt.len_mult));
+    std::memcpy(buffer.data(), wav, length);
+    SDL_FreeWAV(wav);
+
+    cvt.buf = buffer.data();
+    cvt.len = static_cast<int>(length);
+    cvt.len_cvt = cvt.len;
+    if (cvt.needed && SDL_ConvertAudio(&cvt) != 0) {
+        std::cerr << "Can't convert sound: " << path << " | Error: " << SDL_GetError() << "\n";
+        return -1;
+    }
+
+    std::vector<float> frames(cvt.len_cvt / sizeof(float));
+    std::memcpy(frames.data(), buffer.data(), frames.size() * sizeof(float));
+    return addSound(std::move(frames));
+}
+int AudioMixer::addSound(std::vector<float> frames) {
+    if (started) return -1; // Voices point into sounds
+
+    Sound sound;
+    sound.frames = static_cast<int>(frames.size() / 2);
+    sound.samples = std::move(frames);
+    sounds.push_back(std::move(sound));
+    return static_cast<int>(sounds.size()) - 1;
+}
+void AudioMixer::start() {
+    started = true;
+    if (device) SDL_PauseAudioDevice(device, 0);
+}
+void AudioMixer::shutdown() {
+    if (device) {
+        SDL_CloseAudioDevice(device); // Waits for the callback to finish
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        device = 0;
+    }
+    for (Voice& v : voices) v = Voice();
+    sounds.clear();
+    started = false;
+}
+void AudioMixer::play(int sound, float volume, float pan) {
+    if (!device || sound < 0 || sound >= static_cast<int>(sounds.size())) return;
+
+    pan = std::max(-1.0f, std::min(1.0f, pan));
+    Command command;
+    command.sound = sound;
+    command.leftGain = volume * std::min(1.0f, 1.0f - pan);
+    command.rightGain = volume * std::min(1.0f, 1.0f + pan);
+    if (!commands.push(command)) droppedCommands++;
+}
+void AudioMixer::stopAll() {
+    Command command;
+    command.type = Command::Type::StopAll;
+    if (!commands.push(command)) droppedCommands++;
+}
+double AudioMixer::getLatencyMs() const {
+    return frequency > 0 ? bufferFrames * 1000.0 / frequency : 0.0;
+}
+void AudioMixer::startVoice(const Command& command) {
+    // A free voice, or else the one that has played the longest
+    Voice* target = &voices[0];
+    for (Voice& v : voices) {
+        if (!v.sound) {
+            target = &v;
+            break;
+        }
+        if (v.position > target->position) target = &v;
+    }
+
+    target->sound = &sounds[command.sound];
+    target->position = 0;
+    target->leftGain = command.leftGain;
+    target->rightGain = command.rightGain;
+}
+void AudioMixer::mix(float* out, int frames) {
+    Command command;
+    while (commands.pop(command)) {
+        if (command.type == Command::Type::StopAll) {
+            for (Voice& v : voices) v.sound = nullptr;
+        } else {
+            startVoice(command);
+        }
+    }
+
+    std::fill(out, out + frames * 2, 0.0f);
+
+    int active = 0;
+    for (Voice& v : voices) {
+        if (!v.sound) continue;
+
+        int count = std::min(frames, v.sound->frames - v.position);
+        const float* src = v.sound->samples.data() + v.position * 2;
+        for (int i = 0; i < count; ++i) {
+            out[i * 2] += src[i * 2] * v.leftGain;
+            out[i * 2 + 1] += src[i * 2 + 1] * v.rightGain;
+        }
+
+        v.position += count;
+        if (v.position >= v.sound->frames) v.sound = nullptr;
+        else active++;
+    }
+
+    for (int i = 0; i < frames * 2; ++i) out[i] = std::max(-1.0f, std::min(1.0f, out[i])); // Hard clip, a few loud hits at once
+    activeVoices.store(active, std::memory_order_relaxed);
+}
+void SDLCALL AudioMixer::audioCallback(void* userdata, Uint8* stream, int len) {
+    static_cast<AudioMixer*>(userdata)->mix(reinterpret_cast<float*>(stream), len / static_cast<int>(2 * sizeof(float)));
+}
@@ -0,0 +1,88 @@
+# ifndef AUDIOMIXER_HPP
+# define AUDIOMIXER_HPP
+
+# include <string>
+# include <vector>
+# include <atomic>
+# include <SDL2/SDL.h>
+# include "SpscQueue.hpp"
+
+// Sound effects. Every sound is decoded and converted to the device's rate as stereo float when it is loaded,
+// so the audio callback only adds samples together. The game thread sends play commands through a lock-free
+// queue; the callback picks them up at the start of each buffer and mixes a fixed pool of voices, with no locks
+// and no allocation. Load every sound before start().
+
+// Structures
+enum class SoundEffect { // The files in audio/, in loadGameSounds order
+    Swing,
+    Hit,
+    Walk,
+    Count
+};
+
+// Classes
+class AudioMixer {
+    public:
+        static const int MaxVoices = 16; // Sounds playing at once, a new one replaces the furthest along when full
+        static const int BufferFrames = 256; // Asked for per callback (5.8 ms at 44.1 kHz), the device may choose another size
+
+        AudioMixer() = default;
+        AudioMixer(const AudioMixer&) = delete;
+        AudioMixer& operator=(const AudioMixer&) = delete;
+        ~AudioMixer();
+
+        bool init(int frequency = 44100); // Opens the default device, paused; false leaves the game silent
+        bool loadGameSounds(); // audio/swing.wav, hit.wav and walk.wav as SoundEffect ids
+        int loadSound(const std::string& path); // WAV, returns the sound id or -1
+        int addSound(std::vector<float> frames); // Already at the device rate, interleaved stereo; returns the id
+        void start();
+        void shutdown();
+
+        // Game thread
+        void play(int sound, float volume = 1.0f, float pan = 0.0f); // pan -1 left .. 1 right
+        void play(SoundEffect effect, float volume = 1.0f, float pan = 0.0f) { play(static_cast<int>(effect), volume, pan); }
+        void stopAll();
+
+        // Audio thread, public so it can be run without a device
+        void mix(float* out, int frames);
+
+        bool isOpen() const { return device != 0; }
+        int getFrequency() const { return frequency; }
+        double getLatencyMs() const; // One device period, as the device chose it
+        long long getDroppedCommands() const { return droppedCommands; }
+        int getActiveVoices() const { return activeVoices.load(std::memory_order_relaxed); }
+
+    private:
+        struct Sound {
+            std::vector<float> samples; // Interleaved stereo
+            int frames = 0;
+        };
+        struct Command {
+            enum class Type : unsigned char { Play, StopAll } type = Type::Play;
+            int sound = 0;
+            float leftGain = 0.0f;
+            float rightGain = 0.0f;
+        };
+        struct Voice {
+            const Sound* sound = nullptr; // nullptr when free
+            int position = 0; // In frames
+            float leftGain = 0.0f;
+            float rightGain = 0.0f;
+        };
+
+        static void SDLCALL audioCallback(void* userdata, Uint8* stream, int len);
+        void startVoice(const Command& command);
+
+        SDL_AudioDeviceID device = 0;
+        int frequency = 0;
+        int bufferFrames = 0; // What the device actually gave us
+        bool started = false;
+
+        std::vector<Sound> sounds; // Fixed once start() has run
+        SpscQueue<Command, 256> commands;
+        long long droppedCommands = 0; // Game thread only
+        Voice voices[MaxVoices]; // Audio thread only
+        std::atomic<int> activeVoices{ 0 };
+};
+
+# endif
@@ -0,0 +1,148 @@
+// Includes
+# include "Combat.hpp"
+# include "Player.hpp"
+# include <iostream>
+# include <algorithm>
+
+// General Functions
+static inline uint64_t nextRandom(uint64_t& state) { // xorshift64*, cheap enough for millions of rolls per thread
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+static inline int rollDamage(int damage, int variance, uint64_t& rng) {
+    if (variance <= 0 || damage <= 0) return damage;
+
+    int span = variance * 2 + 1;
+    int roll = static_cast<int>(nextRandom(rng) % span) - variance;
+    return damage * (100 + roll) / 100;
+}
+
+// Combat Rules
+int playerHitDamage(int attack, int enemyDefense) {
+    int damage = attack - enemyDefense;
+    if (damage < 0) damage = 0;
+    return damage;
+}
+int enemyHitDamage(int attack, int playerDefense) {
+    int damage = 0;
+    if (playerDefense > 0) {
+        damage = attack * (50 - playerDefense) / 100;
+    } else {
+        damage = attack;
+    }
+
+    if (damage < 0) damage = 0;
+    return damage;
+}
+
+// Game Loop Combat
+void fight(CombatContext* ctx, int playerChoice) {
+    if (ctx->state == CombatState::PlayerTurn) {
+
+        if (playerChoice == 1) { // Attack
+            int damage = playerHitDamage(ctx->player->getAttackDamage(), ctx->enemy->getDefense());
+            if (ctx->onEvent) ctx->onEvent(CombatEvent::PlayerAttack);
+
+            ctx->enemyHealth -= damage;
+            ctx->lastDamage = damage;
+            ctx->playerActed = true;
+
+            if (ctx->enemyHealth <= 0) {
+                ctx->state = CombatState::Victory;
+                return;
+            }
+
+            ctx->state = CombatState::EnemyTurn;
+        }
+
+        else if (playerChoice == 2) { // Use Potion
+            bool used = ctx->player->consumePotion(ctx->player->findFirstPotionSlot());
+
+            if (used) {
+                ctx->playerHealth = ctx->player->health;
+                ctx->playerActed = true;
+                ctx->state = CombatState::EnemyTurn;
+            } else {
+                std::cerr << "No potions available!\n";
+                ctx->state = CombatState::PlayerTurn;
+            }
+        }
+    }
+}
+void enemyTurn(CombatContext* ctx) {
+    if (ctx->state != CombatState::EnemyTurn) return;
+
+    int damage = enemyHitDamage(ctx->enemy->getAttack(), ctx->player->Defense);
+    if (ctx->onEvent) ctx->onEvent(CombatEvent::EnemyHit);
+
+    ctx->playerHealth -= damage;
+    ctx->player->health = ctx->playerHealth;
+
+    if (ctx->playerHealth <= 0) {
+        ctx->state = CombatState::Defeat;
+    } else {
+        ctx->state = CombatState::PlayerTurn;
+    }
+}
+
+// Headless Combat
+BattleLoadout makeLoadout(const Player& player) {
+    BattleLoadout loadout;
+    loadout.health = player.health;
+    loadout.maxHealth = player.maxHealth;
+    loadout.defense = player.Defense;
+    loadout.attack = player.getAttackDamage();
+
+    // fight() always drinks from the first potion slot, so walking the slots in order gives the drinking order
+    for (int i = 0; i < player.inventory.getGeneralSlotCount(); ++i) {
+        const Item* item = player.inventory.getItem(i);
+        const Potion* potion = item ? item->asPotion() : nullptr;
+        if (!potion) continue;
+
+        int heal = potion->getHealAmount();
+        for (int n = 0; n < potion->getStackCount(); ++n)
+            loadout.potionHeals.push_back(heal);
+    }
+
+    return loadout;
+}
+BattleResult resolveBattle(const BattleLoadout& loadout, const EnemyNPC& enemy, const BattleOptions& options, uint64_t& rng) {
+    BattleResult result;
+
+    int playerHealth = loadout.health;
+    int enemyHealth = enemy.getHealth();
+    int playerDamage = playerHitDamage(loadout.attack, enemy.getDefense());
+    int enemyDamage = enemyHitDamage(enemy.getAttack(), loadout.defense);
+    int potionCount = static_cast<int>(loadout.potionHeals.size());
+
+    while (result.turns < options.maxTurns) {
+        result.turns++;
+
+        // Player Turn
+        bool lowHealth = playerHealth * 100 <= loadout.maxHealth * options.potionThreshold;
+        if (lowHealth && playerHealth < loadout.maxHealth && result.potionsUsed < potionCount) {
+            playerHealth = std::min(loadout.maxHealth, playerHealth + loadout.potionHeals[result.potionsUsed]);
+            result.potionsUsed++;
+        } else {
+            enemyHealth -= rollDamage(playerDamage, options.damageVariance, rng);
+            if (enemyHealth <= 0) {
+                result.won = true;
+                result.healthLeft = playerHealth;
+                return result;
+            }
+        }
+
+        // Enemy Turn
+        playerHealth -= rollDamage(enemyDamage, options.damageVariance, rng);
+        if (playerHealth <= 0) {
+            result.healthLeft = 0;
+            return result;
+        }
+    }
+
+    result.timedOut = true;
+    result.healthLeft = playerHealth;
+    return result;
+}
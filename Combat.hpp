@@ -0,0 +1,74 @@
+# ifndef COMBAT_HPP
+# define COMBAT_HPP
+
+# include <cstdint>
+# include <vector>
+# include <functional>
+# include "NPCs.hpp"
+
+// Initial Global Declaration
+class Player;
+
+// Structures and Classes
+enum class CombatState {
+    PlayerTurn,
+    EnemyTurn,
+    Victory,
+    Defeat,
+    WaitingForInput
+};
+enum class CombatEvent { // For sounds and effects, see CombatContext::onEvent
+    PlayerAttack,
+    EnemyHit
+};
+struct CombatContext {
+    Player* player;
+    EnemyNPC* enemy;
+
+    int enemyHealth;
+    int playerHealth;
+
+    CombatState state = CombatState::PlayerTurn;
+
+    int pendingDamage = 0; // for UI feedback
+    int lastDamage = 0; // for UI feedback
+
+    bool playerActed = false;
+
+    std::function<void(CombatEvent)> onEvent; // Optional, called as things happen
+};
+
+// Everything the headless resolver needs to know about the player, snapshot once per loadout
+struct BattleLoadout {
+    int health = 100;
+    int maxHealth = 100;
+    int defense = 0;
+    int attack = 1;
+    std::vector<int> potionHeals; // Heal amount of each potion, in the order fight() would drink them
+};
+struct BattleOptions {
+    int potionThreshold = 30; // Drink when health is at or below this % of max health
+    int damageVariance = 0; // +/- % rolled on every hit, 0 keeps the game's fixed damage
+    int maxTurns = 1000; // Stalemate guard for loadouts that can't hurt each other
+};
+struct BattleResult {
+    bool won = false;
+    bool timedOut = false;
+    int turns = 0;
+    int potionsUsed = 0;
+    int healthLeft = 0;
+};
+
+// Combat Rules (shared by the game loop and the headless resolver)
+int playerHitDamage(int attack, int enemyDefense);
+int enemyHitDamage(int attack, int playerDefense);
+
+// Game Loop Combat
+void fight(CombatContext* ctx, int playerChoice);
+void enemyTurn(CombatContext* ctx);
+
+// Headless Combat
+BattleLoadout makeLoadout(const Player& player);
+BattleResult resolveBattle(const BattleLoadout& loadout, const EnemyNPC& enemy, const BattleOptions& options, uint64_t& rng);
+
+# endif
@@ -0,0 +1,267 @@
+// Headless batch combat simulator, no SDL needed
+// Usage: sim [--enemy ID,..] [--weapon ID] [--armor ID,ID,..] [--potions N] [--potion-id ID] [--levels A-B]
+//            [--battles N] [--threads N] [--threshold PCT] [--variance PCT]
+// Each battle takes the next level in the --levels sweep, so the distributions cover the whole range
+
+// Includes
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <memory>
+# include <thread>
+# include <chrono>
+# include <algorithm>
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include "Player.hpp"
+# include "Combat.hpp"
+# include "JobSystem.hpp"
+
+// Structures
+struct SimConfig {
+    std::vector<int> enemyIDs; // Empty means every enemy in NPCs.txt
+    int weaponID = -1;
+    std::vector<int> armorIDs;
+    int potionCount = 0;
+    int potionID = 7; // Basic Health Potion
+    int levelMin = 0;
+    int levelMax = 0;
+    long long battles = 1000000;
+    int threads = 0;
+    BattleOptions options;
+};
+struct SimStats {
+    long long wins = 0;
+    long long losses = 0;
+    long long timeouts = 0;
+    std::vector<long long> turnsToKill; // Indexed by turn count, wins only
+    std::vector<long long> potionsUsed; // Indexed by potions drunk, all battles
+};
+
+// General Functions
+static std::vector<int> parseIDList(const std::string& s) {
+    std::vector<int> ids;
+    size_t start = 0;
+    while (start < s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos) comma = s.size();
+        ids.push_back(std::stoi(s.substr(start, comma - start)));
+        start = comma + 1;
+    }
+    return ids;
+}
+static bool parseArgs(int argc, char** argv, SimConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--enemy") cfg.enemyIDs = parseIDList(value);
+        else if (arg == "--weapon") cfg.weaponID = std::stoi(value);
+        else if (arg == "--armor") cfg.armorIDs = parseIDList(value);
+        else if (arg == "--potions") cfg.potionCount = std::stoi(value);
+        else if (arg == "--potion-id") cfg.potionID = std::stoi(value);
+        else if (arg == "--battles") cfg.battles = std::stoll(value);
+        else if (arg == "--threads") cfg.threads = std::stoi(value);
+        else if (arg == "--threshold") cfg.options.potionThreshold = std::stoi(value);
+        else if (arg == "--variance") cfg.options.damageVariance = std::stoi(value);
+        else if (arg == "--levels") {
+            auto dash = value.find('-');
+            cfg.levelMin = std::stoi(value.substr(0, dash));
+            cfg.levelMax = dash == std::string::npos ? cfg.levelMin : std::stoi(value.substr(dash + 1));
+        }
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    cfg.levelMin = std::max(0, std::min(cfg.levelMin, Player::MAX_LEVEL));
+    cfg.levelMax = std::max(cfg.levelMin, std::min(cfg.levelMax, Player::MAX_LEVEL));
+    return true;
+}
+static ItemPtr makeItem(const ItemFactory& factory, int id) {
+    auto item = factory.createItem(id);
+    if (!item) std::cerr << "Item ID " << id << " not found\n";
+    return item;
+}
+static std::vector<BattleLoadout> buildLoadouts(const SimConfig& cfg, const ItemFactory& factory) {
+    std::vector<BattleLoadout> loadouts;
+
+    for (int level = cfg.levelMin; level <= cfg.levelMax; ++level) {
+        Player player;
+        player.level = level;
+
+        if (cfg.weaponID != -1) {
+            player.inventory.addItem(makeItem(factory, cfg.weaponID));
+            player.inventory.equipItem(0);
+        }
+        for (int id : cfg.armorIDs) {
+            player.inventory.addItem(makeItem(factory, id));
+            player.inventory.equipItem(0);
+        }
+
+        int remaining = cfg.potionCount;
+        while (remaining > 0) {
+            const ItemDefinition* def = factory.getRegistry().find(cfg.potionID);
+            if (!def) break;
+
+            int stack = std::min(remaining, def->MaxStack);
+            auto potion = ItemFactory::createItem(def, stack);
+            remaining -= stack;
+            if (!player.inventory.addItem(std::move(potion))) break;
+        }
+
+        player.recalculateStats();
+        player.health = player.maxHealth;
+        loadouts.push_back(makeLoadout(player));
+    }
+
+    return loadouts;
+}
+static void runBattles(const std::vector<BattleLoadout>& loadouts, const EnemyNPC& enemy, const BattleOptions& options,
+                       long long first, long long count, SimStats& stats) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(first + 1);
+    size_t levels = loadouts.size();
+
+    for (long long i = first; i < first + count; ++i) {
+        BattleResult r = resolveBattle(loadouts[i % levels], enemy, options, rng);
+
+        if (r.won) {
+            stats.wins++;
+            stats.turnsToKill[r.turns]++;
+        }
+        else if (r.timedOut) stats.timeouts++;
+        else stats.losses++;
+
+        stats.potionsUsed[r.potionsUsed]++;
+    }
+}
+static void printDistribution(const char* label, const std::vector<long long>& hist) {
+    long long total = 0;
+    for (long long c : hist) total += c;
+    if (total == 0) {
+        std::cout << label << ": n/a\n";
+        return;
+    }
+
+    auto percentile = [&](double p) {
+        long long target = static_cast<long long>(p * (total - 1));
+        long long seen = 0;
+        for (size_t i = 0; i < hist.size(); ++i) {
+            seen += hist[i];
+            if (seen > target) return static_cast<int>(i);
+        }
+        return static_cast<int>(hist.size() - 1);
+    };
+
+    double sum = 0;
+    int lo = -1, hi = 0;
+    long long peak = 0;
+    for (size_t i = 0; i < hist.size(); ++i) {
+        if (!hist[i]) continue;
+        if (lo == -1) lo = static_cast<int>(i);
+        hi = static_cast<int>(i);
+        sum += static_cast<double>(hist[i]) * i;
+        peak = std::max(peak, hist[i]);
+    }
+
+    std::cout << label << ": min " << lo << " / avg " << std::fixed << std::setprecision(2) << sum / total
+              << " / p50 " << percentile(0.5) << " / p90 " << percentile(0.9) << " / p99 " << percentile(0.99)
+              << " / max " << hi << "\n";
+
+    for (int i = lo; i <= hi; ++i) {
+        if (!hist[i]) continue;
+        int bar = static_cast<int>(40 * hist[i] / peak);
+        std::cout << std::setw(6) << i << " | " << std::string(bar, '#') << " "
+                  << std::setprecision(2) << 100.0 * hist[i] / total << "%\n";
+    }
+}
+
+// Main Function for execution
+int main(int argc, char** argv) {
+    SimConfig cfg;
+    if (!parseArgs(argc, argv, cfg)) return 1;
+
+    if (cfg.threads <= 0) cfg.threads = std::max(1u, std::thread::hardware_concurrency());
+    JobSystem jobs(cfg.threads);
+
+    NPCFactory npcfactory;
+    auto npcs = npcfactory.loadNPCs("NPCs.txt");
+
+    if (cfg.enemyIDs.empty()) {
+        for (auto& pair : npcs) {
+            if (pair.second->getType() == NPCType::Enemy) cfg.enemyIDs.push_back(pair.first);
+        }
+        std::sort(cfg.enemyIDs.begin(), cfg.enemyIDs.end());
+    }
+
+    ItemFactory itemfactory;
+    itemfactory.loadItems("ItemList.txt");
+    auto loadouts = buildLoadouts(cfg, itemfactory);
+
+    std::cout << "Levels " << cfg.levelMin << "-" << cfg.levelMax << ", attack " << loadouts[0].attack
+              << ", defense " << loadouts[0].defense << ", potions " << loadouts[0].potionHeals.size()
+              << ", " << cfg.battles << " battles per enemy on " << cfg.threads << " threads\n";
+
+    for (int id : cfg.enemyIDs) {
+        auto it = npcs.find(id);
+        EnemyNPC* enemy = it == npcs.end() ? nullptr : dynamic_cast<EnemyNPC*>(it->second.get());
+        if (!enemy) {
+            std::cerr << "NPC ID " << id << " is not an enemy\n";
+            continue;
+        }
+
+        // Several pieces per thread so a slow piece doesn't leave the others idle; the split only depends on --threads
+        int pieces = cfg.threads * 8;
+        std::vector<SimStats> perPiece(pieces);
+        for (auto& s : perPiece) {
+            s.turnsToKill.assign(cfg.options.maxTurns + 1, 0);
+            s.potionsUsed.assign(loadouts[0].potionHeals.size() + 1, 0);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        long long chunk = cfg.battles / pieces;
+        jobs.parallelFor(0, pieces, 1, [&](int firstPiece, int lastPiece) {
+            for (int p = firstPiece; p < lastPiece; ++p) {
+                long long first = p * chunk;
+                long long count = (p == pieces - 1) ? cfg.battles - first : chunk;
+                runBattles(loadouts, *enemy, cfg.options, first, count, perPiece[p]);
+            }
+        });
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SimStats total = perPiece[0];
+        for (int p = 1; p < pieces; ++p) {
+            total.wins += perPiece[p].wins;
+            total.losses += perPiece[p].losses;
+            total.timeouts += perPiece[p].timeouts;
+            for (size_t i = 0; i < total.turnsToKill.size(); ++i) total.turnsToKill[i] += perPiece[p].turnsToKill[i];
+            for (size_t i = 0; i < total.potionsUsed.size(); ++i) total.potionsUsed[i] += perPiece[p].potionsUsed[i];
+        }
+
+        std::cout << "\n=== " << enemy->getName() << " (ID " << id << ") ===\n";
+        std::cout << "Win rate: " << std::fixed << std::setprecision(2) << 100.0 * total.wins / cfg.battles
+                  << "% (wins " << total.wins << ", losses " << total.losses << ", timeouts " << total.timeouts << ")\n";
+        printDistribution("Turns to kill", total.turnsToKill);
+        printDistribution("Potions used", total.potionsUsed);
+        std::cout << "Throughput: " << std::setprecision(1) << cfg.battles / seconds / 1e6 << "M battles/s\n";
+    }
+
+    if (cfg.threads > 1) { // One thread runs everything inline
+        std::cout << "\nThread busy:";
+        for (const WorkerStats& w : jobs.getStats()) std::cout << " " << std::setprecision(0) << 100.0 * w.utilisation << "%";
+        std::cout << "\n";
+    }
+
+    return 0;
+}
+
+// Build with:
+// g++ -O2 Combat_Simulator.cpp Combat.cpp RPG_Inventory_System.cpp NPCs.cpp GameData.cpp TextParser.cpp JobSystem.cpp -pthread -o sim
@@ -0,0 +1,133 @@
+// Includes
+# include "ContentPack.hpp"
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include "TextParser.hpp"
+# include <iostream>
+# include <filesystem>
+# include <algorithm>
+
+// Structures
+struct ParsedContentFile {
+    bool isNPC = false;
+    bool opened = false;
+    std::vector<std::unique_ptr<ItemDefinition>> items;
+    std::vector<std::unique_ptr<NPC>> npcs;
+    std::vector<ParseDiagnostic> diagnostics;
+};
+
+// General Functions
+static bool endsWith(const std::string& s, const char* suffix) {
+    size_t n = std::char_traits<char>::length(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+static void parseContentFile(const std::string& path, std::string& buffer, ParsedContentFile& out) {
+    out.isNPC = endsWith(path, ".npcs.txt");
+    out.opened = readTextFile(path, buffer);
+    if (!out.opened) return;
+
+    if (out.isNPC) out.npcs = NPCFactory::parseNPCs(buffer, out.diagnostics);
+    else out.items = ItemFactory::parseItems(buffer, out.diagnostics);
+}
+
+// Content Pack Functions
+std::vector<std::string> findContentFiles(const std::string& directory) {
+    namespace fs = std::filesystem;
+    std::vector<std::pair<std::string, std::string>> found; // Relative path for ordering, full path for loading
+    std::error_code ec;
+
+    for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+
+        std::string name = it->path().filename().string();
+        if (!endsWith(name, ".items.txt") && !endsWith(name, ".npcs.txt")) continue;
+
+        found.emplace_back(it->path().lexically_relative(directory).generic_string(), it->path().string());
+    }
+
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::string> files;
+    files.reserve(found.size());
+    for (auto& f : found) files.push_back(std::move(f.second));
+    return files;
+}
+ContentPack loadContentPack(const std::string& directory, ItemFactory& itemfactory,
+                            std::unordered_map<int, std::unique_ptr<NPC>> baseNPCs, JobSystem& jobs) {
+    ContentPack pack;
+    pack.npcs = std::move(baseNPCs);
+
+    std::vector<std::string> files = findContentFiles(directory);
+    std::vector<ParsedContentFile> parsed(files.size());
+    if (files.empty()) return pack;
+
+    // Parse, one file per job so one huge region file doesn't hold up a whole slice
+    jobs.parallelFor(0, static_cast<int>(files.size()), 1, [&](int first, int last) {
+        std::string buffer;
+        for (int i = first; i < last; ++i) parseContentFile(files[i], buffer, parsed[i]);
+    });
+
+    // Merge in path order
+    ItemRegistry& registry = itemfactory.getRegistry();
+    std::unordered_map<int, size_t> itemOrigin;
+    std::unordered_map<int, size_t> npcOrigin;
+
+    size_t totalItems = 0;
+    for (auto& p : parsed) totalItems += p.items.size();
+    registry.reserve(static_cast<int>(totalItems));
+
+    // Only definitions from before the pack can have live items, pack files may change kinds between themselves
+    std::unordered_set<int> baseItemIDs;
+    for (const ItemDefinition* def : registry.getDefinitions()) baseItemIDs.insert(def->ItemID);
+
+    auto recordOverride = [&](bool isNPC, int id, size_t file, std::unordered_map<int, size_t>& origin, bool existed) {
+        auto it = origin.find(id);
+        if (it != origin.end()) pack.overrides.push_back({ isNPC, id, files[file], files[it->second] });
+        else if (existed) pack.overrides.push_back({ isNPC, id, files[file], "" });
+        origin[id] = file;
+    };
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        ParsedContentFile& p = parsed[i];
+
+        if (!p.opened) {
+            std::cerr << "Failed to open content file: " << files[i] << "\n";
+            pack.failedFiles++;
+            continue;
+        }
+
+        reportDiagnostics(files[i], p.diagnostics);
+        pack.diagnosticCount += static_cast<int>(p.diagnostics.size());
+
+        if (p.isNPC) {
+            pack.npcFiles++;
+            pack.npcCount += static_cast<int>(p.npcs.size());
+            for (auto& npc : p.npcs) {
+                int id = npc->getID();
+                recordOverride(true, id, i, npcOrigin, pack.npcs.count(id) > 0);
+                pack.npcs[id] = std::move(npc);
+                pack.npcIDs.insert(id);
+            }
+        } else {
+            pack.itemFiles++;
+            pack.itemCount += static_cast<int>(p.items.size());
+            for (auto& def : p.items) {
+                int id = def->ItemID;
+                const ItemDefinition* existing = registry.find(id);
+
+                // Items already built from the base definition are the old class, same rule as hot reload
+                if (existing && existing->Kind != def->Kind && baseItemIDs.count(id)) {
+                    std::cerr << files[i] << ": item " << id << " changes kind, definition skipped\n";
+                    pack.diagnosticCount++;
+                    continue;
+                }
+
+                recordOverride(false, id, i, itemOrigin, existing != nullptr);
+                registry.add(std::move(def));
+                pack.itemIDs.insert(id);
+            }
+        }
+    }
+
+    return pack;
+}
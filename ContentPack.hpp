@@ -0,0 +1,47 @@
+# ifndef CONTENTPACK_HPP
+# define CONTENTPACK_HPP
+
+# include <string>
+# include <vector>
+# include <memory>
+# include <unordered_map>
+# include <unordered_set>
+# include "JobSystem.hpp"
+
+// Content packs: a directory tree of *.items.txt and *.npcs.txt files (one per region or mod)
+// Files are parsed as jobs and merged on the calling thread in path order, so the result never depends on timing.
+// Override order: anything already in the factory registry, then the pack files sorted by their path inside the pack,
+// then the blocks inside each file from top to bottom. The last definition of an ID wins, unless it changes the kind
+// of an item loaded before the pack: items may already exist as the old class, so that definition is skipped.
+
+// Class Declarations
+class ItemFactory;
+class NPC;
+
+// Structures
+struct ContentOverride {
+    bool isNPC;
+    int id;
+    std::string file; // The file whose definition won
+    std::string previousFile; // Empty when it replaced something loaded before the pack
+};
+struct ContentPack {
+    std::unordered_map<int, std::unique_ptr<NPC>> npcs;
+    std::vector<ContentOverride> overrides;
+    std::unordered_set<int> itemIDs; // Every ID whose winning definition came from the pack
+    std::unordered_set<int> npcIDs;
+    int itemFiles = 0;
+    int npcFiles = 0;
+    int itemCount = 0; // Definitions parsed, including ones that were overridden
+    int npcCount = 0;
+    int diagnosticCount = 0;
+    int failedFiles = 0;
+};
+
+// Functions
+std::vector<std::string> findContentFiles(const std::string& directory); // Sorted in override order
+// Registers the pack's items with itemfactory and returns its NPCs merged over baseNPCs
+ContentPack loadContentPack(const std::string& directory, ItemFactory& itemfactory,
+                            std::unordered_map<int, std::unique_ptr<NPC>> baseNPCs = {}, JobSystem& jobs = jobSystem());
+
+# endif
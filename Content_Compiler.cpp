@@ -0,0 +1,46 @@
+// Compiles the text content files into GameData.bin for the fast mmap loading path
+// Usage: compiler [ItemList.txt] [NPCs.txt] [GameData.bin]
+
+// Includes
+# include <iostream>
+# include <string>
+# include <vector>
+# include <algorithm>
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include "GameData.hpp"
+
+// Main Function for execution
+int main(int argc, char** argv) {
+    std::string itemFile = argc > 1 ? argv[1] : "ItemList.txt";
+    std::string npcFile = argc > 2 ? argv[2] : "NPCs.txt";
+    std::string outFile = argc > 3 ? argv[3] : "GameData.bin";
+
+    ItemFactory itemfactory;
+    NPCFactory npcfactory;
+    itemfactory.loadItems(itemFile);
+    auto npcs = npcfactory.loadNPCs(npcFile);
+
+    // The game falls back to the text files quietly, the compiler is where bad content should stop
+    if (!itemfactory.getDiagnostics().empty() || !npcfactory.getDiagnostics().empty()) {
+        std::cerr << "Not compiling, fix the problems above first\n";
+        return 1;
+    }
+
+    std::vector<const NPC*> npcList;
+    for (auto& pair : npcs) npcList.push_back(pair.second.get());
+    std::sort(npcList.begin(), npcList.end(), [](const NPC* a, const NPC* b) { return a->getID() < b->getID(); });
+
+    auto items = itemfactory.getRegistry().getDefinitions();
+    if (!writeGameData(outFile, items, npcList)) return 1;
+
+    // Read it back so a bad write never ships
+    GameDataFile check;
+    if (!check.open(outFile)) return 1;
+
+    std::cout << "Compiled " << items.size() << " items and " << npcList.size() << " NPCs into " << outFile << "\n";
+    return 0;
+}
+
+// Build with:
+// g++ -O2 Content_Compiler.cpp GameData.cpp RPG_Inventory_System.cpp NPCs.cpp TextParser.cpp -o compiler
@@ -0,0 +1,54 @@
+// Includes
+# include "GameClock.hpp"
+# include <algorithm>
+
+// FixedTimestep Functions
+FixedTimestep::FixedTimestep(int tickRate, double maxFrameSeconds) : tickRate(std::max(1, tickRate)) {
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    tickLength = std::max<Uint64>(1, frequency / this->tickRate);
+    maxFrame = std::max(tickLength, static_cast<Uint64>(maxFrameSeconds * frequency));
+}
+int FixedTimestep::advance() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (!started) {
+        started = true;
+        last = now;
+    }
+
+    accumulator += std::min(now - last, maxFrame);
+    last = now;
+
+    int ticks = static_cast<int>(accumulator / tickLength);
+    accumulator -= ticks * tickLength;
+    return ticks;
+}
+void FixedTimestep::reset() {
+    last = SDL_GetPerformanceCounter();
+    accumulator = 0;
+}
+double FixedTimestep::getAlpha() const {
+    return static_cast<double>(accumulator) / tickLength;
+}
+
+// FrameLimiter Functions
+FrameLimiter::FrameLimiter(int maxFPS) {
+    if (maxFPS > 0) frameLength = SDL_GetPerformanceFrequency() / maxFPS;
+}
+void FrameLimiter::wait() {
+    if (frameLength == 0) return;
+
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (next == 0) next = now;
+
+    // Sleep while there's more than 2ms to go, SDL_Delay can overshoot by a millisecond, then spin to the deadline
+    while (now < next) {
+        Uint64 remainingMs = (next - now) * 1000 / frequency;
+        if (remainingMs > 2) SDL_Delay(static_cast<Uint32>(remainingMs - 2));
+        now = SDL_GetPerformanceCounter();
+    }
+
+    // Step from the deadline, not from now, so small overshoots don't add up; start over after a long stall
+    next += frameLength;
+    if (now > next + frameLength) next = now + frameLength;
+}
@@ -0,0 +1,42 @@
+# ifndef GAMECLOCK_HPP
+# define GAMECLOCK_HPP
+
+# include <SDL2/SDL.h>
+
+// Frame timing on SDL's performance counter.
+// FixedTimestep turns real time into a whole number of simulation ticks per frame, so game speed no longer
+// depends on how long a frame took; FrameLimiter caps how often frames are drawn.
+
+// Classes
+class FixedTimestep {
+    public:
+        explicit FixedTimestep(int tickRate = 60, double maxFrameSeconds = 0.25);
+
+        int advance(); // Ticks to run this frame, call once per frame
+        void reset(); // Forget time passed since the last advance, e.g. after a blocking pause
+
+        double getTickSeconds() const { return 1.0 / tickRate; }
+        double getAlpha() const; // 0..1, how far real time is past the last tick, for drawing between ticks
+        int getTickRate() const { return tickRate; }
+
+    private:
+        int tickRate;
+        Uint64 tickLength; // In performance counter units
+        Uint64 maxFrame; // Longer frames (breakpoints, dragging the window) are cut to this rather than caught up on
+        Uint64 last = 0;
+        Uint64 accumulator = 0;
+        bool started = false;
+};
+
+class FrameLimiter {
+    public:
+        explicit FrameLimiter(int maxFPS = 60); // 0 = no limit
+
+        void wait(); // Call once per frame after present
+
+    private:
+        Uint64 frameLength = 0;
+        Uint64 next = 0;
+};
+
+# endif
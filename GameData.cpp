@@ -0,0 +1,248 @@
+// Includes
+# include "GameData.hpp"
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include <iostream>
+# include <fstream>
+# include <cstring>
+# include <filesystem>
+# ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+# else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+# endif
+
+// General Functions
+uint32_t gameDataChecksum(const unsigned char* data, size_t size) {
+    // FNV-1a over 8 byte words, a byte at a time made opening the file cost more than loading it
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+    for (; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+static uint32_t addString(std::string& table, std::string_view s) {
+    uint32_t offset = static_cast<uint32_t>(table.size());
+    table += s;
+    return offset;
+}
+
+// MappedFile Functions
+MappedFile::~MappedFile() { close(); }
+bool MappedFile::open(const std::string& path) {
+    close();
+
+# ifdef _WIN32
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fh, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(fh);
+        return false;
+    }
+
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) {
+        CloseHandle(fh);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mh);
+        CloseHandle(fh);
+        return false;
+    }
+
+    fileHandle = fh;
+    mappingHandle = mh;
+    bytes = static_cast<const unsigned char*>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+# else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+
+    bytes = static_cast<const unsigned char*>(view);
+    length = static_cast<size_t>(st.st_size);
+# endif
+
+    return true;
+}
+void MappedFile::close() {
+    if (!bytes) return;
+
+# ifdef _WIN32
+    UnmapViewOfFile(bytes);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+# else
+    munmap(const_cast<unsigned char*>(bytes), length);
+# endif
+
+    bytes = nullptr;
+    length = 0;
+}
+
+// GameDataFile Functions
+bool GameDataFile::open(const std::string& path) {
+    close();
+
+    file = std::make_shared<MappedFile>();
+    if (!file->open(path)) {
+        file.reset();
+        return false;
+    }
+
+    auto fail = [&](const char* why) {
+        std::cerr << "Bad game data file " << path << ": " << why << "\n";
+        close();
+        return false;
+    };
+
+    if (file->size() < sizeof(GameDataHeader)) return fail("too small");
+
+    header = reinterpret_cast<const GameDataHeader*>(file->data());
+    if (std::memcmp(header->magic, GameDataMagic, sizeof(GameDataMagic)) != 0) return fail("wrong magic");
+    if (header->version != GameDataVersion) return fail("version mismatch, recompile it");
+    if (header->fileSize != file->size()) return fail("truncated");
+
+    uint64_t itemEnd = uint64_t(header->itemOffset) + uint64_t(header->itemCount) * sizeof(ItemRecord);
+    uint64_t npcEnd = uint64_t(header->npcOffset) + uint64_t(header->npcCount) * sizeof(NPCRecord);
+    uint64_t stringEnd = uint64_t(header->stringOffset) + header->stringSize;
+    if (itemEnd > file->size() || npcEnd > file->size() || stringEnd > file->size()) return fail("section out of range");
+    if (header->itemOffset % alignof(ItemRecord) || header->npcOffset % alignof(NPCRecord)) return fail("misaligned section");
+
+    const unsigned char* body = file->data() + sizeof(GameDataHeader);
+    if (gameDataChecksum(body, file->size() - sizeof(GameDataHeader)) != header->checksum) return fail("checksum mismatch");
+
+    items = reinterpret_cast<const ItemRecord*>(file->data() + header->itemOffset);
+    npcs = reinterpret_cast<const NPCRecord*>(file->data() + header->npcOffset);
+    strings = reinterpret_cast<const char*>(file->data() + header->stringOffset);
+    return true;
+}
+void GameDataFile::close() {
+    file.reset();
+    header = nullptr;
+    items = nullptr;
+    npcs = nullptr;
+    strings = nullptr;
+}
+int GameDataFile::getItemCount() const { return header ? static_cast<int>(header->itemCount) : 0; }
+int GameDataFile::getNPCCount() const { return header ? static_cast<int>(header->npcCount) : 0; }
+const ItemRecord& GameDataFile::getItem(int index) const { return items[index]; }
+const NPCRecord& GameDataFile::getNPC(int index) const { return npcs[index]; }
+std::string_view GameDataFile::getString(uint32_t offset, uint32_t length) const {
+    if (!header || uint64_t(offset) + length > header->stringSize) return {};
+    return std::string_view(strings + offset, length);
+}
+
+// Writer Functions
+bool writeGameData(const std::string& path, const std::vector<const ItemDefinition*>& items, const std::vector<const NPC*>& npcs) {
+    std::string table;
+    std::vector<ItemRecord> itemRecords;
+    std::vector<NPCRecord> npcRecords;
+    itemRecords.reserve(items.size());
+    npcRecords.reserve(npcs.size());
+
+    for (const ItemDefinition* def : items) {
+        ItemRecord r{};
+        r.id = def->ItemID;
+        r.kind = static_cast<uint8_t>(def->Kind);
+        r.slot = static_cast<uint8_t>(def->Slot);
+        r.traits = def->Traits.getBits();
+        r.removes = def->Removes.getBits();
+        r.maxStack = def->MaxStack;
+        r.damage = def->Damage;
+        r.defense = def->Defense;
+        r.healthBonus = def->HealthBonus;
+        r.healAmount = def->HealAmount;
+        r.nameLength = static_cast<uint32_t>(def->Name.size());
+        r.nameOffset = addString(table, def->Name);
+        r.descLength = static_cast<uint32_t>(def->Description.size());
+        r.descOffset = addString(table, def->Description);
+        itemRecords.push_back(r);
+    }
+
+    for (const NPC* npc : npcs) {
+        NPCRecord r{};
+        r.id = npc->getID();
+        r.type = static_cast<uint8_t>(npc->getType());
+        r.health = npc->getHealth();
+        r.attack = npc->getAttack();
+        r.defense = npc->getDefense();
+        r.xp = npc->getXP();
+        r.gold = npc->getGold();
+        if (const FriendlyNPC* friendly = dynamic_cast<const FriendlyNPC*>(npc)) {
+            r.job = static_cast<uint8_t>(friendly->getJob());
+        }
+        r.nameLength = static_cast<uint32_t>(npc->getName().size());
+        r.nameOffset = addString(table, npc->getName());
+        npcRecords.push_back(r);
+    }
+
+    GameDataHeader header{};
+    std::memcpy(header.magic, GameDataMagic, sizeof(GameDataMagic));
+    header.version = GameDataVersion;
+    header.itemCount = static_cast<uint32_t>(itemRecords.size());
+    header.npcCount = static_cast<uint32_t>(npcRecords.size());
+    header.itemOffset = sizeof(GameDataHeader);
+    header.npcOffset = header.itemOffset + header.itemCount * sizeof(ItemRecord);
+    header.stringOffset = header.npcOffset + header.npcCount * sizeof(NPCRecord);
+    header.stringSize = static_cast<uint32_t>(table.size());
+    header.fileSize = header.stringOffset + header.stringSize;
+
+    std::vector<unsigned char> body(header.fileSize - sizeof(GameDataHeader));
+    unsigned char* out = body.data();
+    if (!itemRecords.empty()) std::memcpy(out, itemRecords.data(), itemRecords.size() * sizeof(ItemRecord));
+    out += itemRecords.size() * sizeof(ItemRecord);
+    if (!npcRecords.empty()) std::memcpy(out, npcRecords.data(), npcRecords.size() * sizeof(NPCRecord));
+    out += npcRecords.size() * sizeof(NPCRecord);
+    if (!table.empty()) std::memcpy(out, table.data(), table.size());
+    header.checksum = gameDataChecksum(body.data(), body.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open game data file for writing: " << path << "\n";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+    return static_cast<bool>(file);
+}
+bool isGameDataFresh(const std::string& path, const std::vector<std::string>& sources) {
+    std::error_code ec;
+    auto compiled = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    for (const auto& source : sources) {
+        auto modified = std::filesystem::last_write_time(source, ec);
+        if (!ec && modified > compiled) return false;
+    }
+    return true;
+}
@@ -0,0 +1,114 @@
+# ifndef GAMEDATA_HPP
+# define GAMEDATA_HPP
+
+# include <cstdint>
+# include <memory>
+# include <string>
+# include <string_view>
+# include <vector>
+
+// Compiled content file (GameData.bin), written by Content_Compiler from ItemList.txt and NPCs.txt
+// Layout: GameDataHeader, ItemRecord[itemCount], NPCRecord[npcCount], string table
+// Everything is little endian and fixed size, so the loader reads the records straight out of the mapping
+
+// Forward Declarations
+struct ItemDefinition;
+class NPC;
+
+// Structures
+constexpr char GameDataMagic[4] = { 'T', 'M', 'G', 'D' };
+constexpr uint32_t GameDataVersion = 2; // 2: word-wise checksum
+
+struct GameDataHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t checksum; // 64-bit FNV-1a over 8 byte words of everything after the header, folded to 32
+    uint32_t itemCount;
+    uint32_t npcCount;
+    uint32_t itemOffset;
+    uint32_t npcOffset;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+    uint32_t fileSize;
+};
+struct ItemRecord {
+    int32_t id;
+    uint8_t kind; // ItemKind
+    uint8_t slot; // ArmorSlotType
+    uint8_t traits; // Bit per Trait
+    uint8_t removes; // Bit per Trait
+    int32_t maxStack;
+    int32_t damage;
+    int32_t defense;
+    int32_t healthBonus;
+    int32_t healAmount;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t descOffset;
+    uint32_t descLength;
+};
+struct NPCRecord {
+    int32_t id;
+    uint8_t type; // NPCType
+    uint8_t job; // FriendlyJob
+    uint16_t reserved;
+    int32_t health;
+    int32_t attack;
+    int32_t defense;
+    int32_t xp;
+    int32_t gold;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+static_assert(sizeof(GameDataHeader) == 40, "GameDataHeader layout changed, bump GameDataVersion");
+static_assert(sizeof(ItemRecord) == 44, "ItemRecord layout changed, bump GameDataVersion");
+static_assert(sizeof(NPCRecord) == 36, "NPCRecord layout changed, bump GameDataVersion");
+
+// Classes
+class MappedFile {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        bool open(const std::string& path);
+        void close();
+
+        const unsigned char* data() const { return bytes; }
+        size_t size() const { return length; }
+
+    private:
+        const unsigned char* bytes = nullptr;
+        size_t length = 0;
+# ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+# endif
+};
+class GameDataFile {
+    public:
+        bool open(const std::string& path); // Maps and validates magic, version, sizes and checksum
+        void close(); // Unmaps once nobody else holds getMapping()
+
+        int getItemCount() const;
+        int getNPCCount() const;
+        const ItemRecord& getItem(int index) const;
+        const NPCRecord& getNPC(int index) const;
+        std::string_view getString(uint32_t offset, uint32_t length) const;
+        std::shared_ptr<const MappedFile> getMapping() const { return file; } // Hold it to keep getString() views valid after close()
+
+    private:
+        std::shared_ptr<MappedFile> file;
+        const GameDataHeader* header = nullptr;
+        const ItemRecord* items = nullptr;
+        const NPCRecord* npcs = nullptr;
+        const char* strings = nullptr;
+};
+
+// Functions
+uint32_t gameDataChecksum(const unsigned char* data, size_t size);
+bool writeGameData(const std::string& path, const std::vector<const ItemDefinition*>& items, const std::vector<const NPC*>& npcs);
+bool isGameDataFresh(const std::string& path, const std::vector<std::string>& sources); // Exists and newer than every source
+
+# endif
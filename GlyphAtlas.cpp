@@ -0,0 +1,152 @@
+// Includes
+# include "GlyphAtlas.hpp"
+# include "RectPacker.hpp"
+# include <iostream>
+# include <algorithm>
+
+// GlyphAtlas Functions
+GlyphAtlas::~GlyphAtlas() { destroy(); }
+void GlyphAtlas::destroy() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+}
+int GlyphAtlas::glyphIndex(char c) {
+    int code = static_cast<unsigned char>(c);
+    if (code < FirstGlyph || code > LastGlyph) code = '?';
+    return code - FirstGlyph;
+}
+int GlyphAtlas::kerning(int previous, int current) const {
+    return kerningTable[previous * GlyphCount + current];
+}
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    destroy();
+    if (!font) return false;
+
+    fontHeight = TTF_FontHeight(font);
+    lineSkip = TTF_FontLineSkip(font);
+
+    // Render every glyph once, white so colour can come from the vertex colour
+    SDL_Color white = { 255, 255, 255, 255 };
+    std::array<SDL_Surface*, GlyphCount> surfaces{};
+    for (int i = 0; i < GlyphCount; ++i) {
+        Uint16 ch = static_cast<Uint16>(FirstGlyph + i);
+
+        int minX, maxX, minY, maxY, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &advance) == 0) glyphs[i].advance = advance;
+
+        SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, ch, white);
+        if (!rendered) continue; // Space and friends, advance only
+
+        surfaces[i] = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(rendered);
+        if (surfaces[i]) SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+    }
+
+    kerningTable.assign(GlyphCount * GlyphCount, 0);
+    for (int a = 0; a < GlyphCount; ++a) {
+        for (int b = 0; b < GlyphCount; ++b) {
+            int k = TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(FirstGlyph + a), static_cast<Uint16>(FirstGlyph + b));
+            kerningTable[a * GlyphCount + b] = static_cast<signed char>(std::max(-128, std::min(127, k)));
+        }
+    }
+
+    // Pack, growing the page until all of ASCII fits
+    int pageSize = 128;
+    for (bool packed = false; !packed && pageSize <= 4096;) {
+        RectPacker packer(pageSize, pageSize);
+        packed = true;
+        for (int i = 0; i < GlyphCount && packed; ++i) {
+            if (!surfaces[i]) continue;
+            packed = packer.insert(surfaces[i]->w + 1, surfaces[i]->h + 1, glyphs[i].src.x, glyphs[i].src.y);
+            glyphs[i].src.w = surfaces[i]->w;
+            glyphs[i].src.h = surfaces[i]->h;
+        }
+        if (!packed) pageSize *= 2;
+    }
+
+    SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (page) {
+        for (int i = 0; i < GlyphCount; ++i) {
+            if (!surfaces[i]) continue;
+            SDL_Rect dst = glyphs[i].src;
+            SDL_BlitSurface(surfaces[i], nullptr, page, &dst);
+        }
+        texture = SDL_CreateTextureFromSurface(renderer, page);
+        SDL_FreeSurface(page);
+    }
+    for (SDL_Surface* s : surfaces) SDL_FreeSurface(s);
+
+    if (!texture) {
+        std::cerr << "Failed to build glyph atlas: " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+int GlyphAtlas::wordWidth(std::string_view word) const {
+    int width = 0;
+    int previous = -1;
+    for (char c : word) {
+        int index = glyphIndex(c);
+        if (previous >= 0) width += kerning(previous, index);
+        width += glyphs[index].advance;
+        previous = index;
+    }
+    return width;
+}
+template <typename Fn>
+void GlyphAtlas::layout(std::string_view text, int wrapWidth, Fn&& emit) const {
+    int penX = 0;
+    int penY = 0;
+    int previous = -1;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '\n') {
+            penX = 0;
+            penY += lineSkip;
+            previous = -1;
+            continue;
+        }
+
+        // Wrap before a word that would run past the edge, never in the middle of one
+        bool wordStart = c != ' ' && (i == 0 || text[i - 1] == ' ');
+        if (wrapWidth > 0 && wordStart && penX > 0) {
+            size_t end = text.find_first_of(" \n", i);
+            std::string_view word = text.substr(i, end == std::string_view::npos ? std::string_view::npos : end - i);
+            if (penX + wordWidth(word) > wrapWidth) {
+                penX = 0;
+                penY += lineSkip;
+                previous = -1;
+            }
+        }
+
+        int index = glyphIndex(c);
+        if (previous >= 0) penX += kerning(previous, index);
+        emit(glyphs[index], penX, penY);
+        penX += glyphs[index].advance;
+        previous = index;
+    }
+}
+SDL_Point GlyphAtlas::measure(std::string_view text, int wrapWidth) const {
+    SDL_Point size{ 0, 0 };
+    if (text.empty()) return size;
+
+    int lastY = 0;
+    layout(text, wrapWidth, [&](const Glyph& g, int x, int y) {
+        size.x = std::max(size.x, x + g.advance);
+        lastY = y;
+    });
+    size.y = lastY + fontHeight;
+    return size;
+}
+void GlyphAtlas::draw(RenderQueue& queue, RenderLayer layer, std::string_view text, int x, int y, SDL_Color color, int wrapWidth) const {
+    if (!texture) return;
+
+    layout(text, wrapWidth, [&](const Glyph& g, int gx, int gy) {
+        if (g.src.w == 0) return;
+
+        SDL_Rect dst{ x + gx, y + gy, g.src.w, g.src.h };
+        queue.copy(layer, texture, &g.src, dst, color); // Colour rides on the vertices
+    });
+}
@@ -0,0 +1,57 @@
+# ifndef GLYPHATLAS_HPP
+# define GLYPHATLAS_HPP
+
+# include <array>
+# include <string_view>
+# include <vector>
+# include <SDL2/SDL.h>
+# include <SDL2/SDL_ttf.h>
+# include "RenderQueue.hpp"
+
+// Printable ASCII of one font baked into a single texture, with the kerning table looked up ahead of time.
+// Drawing queues one quad per glyph, all from that texture, so a whole string batches into one call: no TTF rendering or texture uploads per call.
+// Anything outside ' '..'~' is drawn as '?'.
+
+// Classes
+class GlyphAtlas {
+    public:
+        GlyphAtlas() = default;
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+        ~GlyphAtlas();
+
+        bool build(SDL_Renderer* renderer, TTF_Font* font);
+        void destroy();
+        bool isReady() const { return texture != nullptr; }
+
+        // wrapWidth > 0 breaks lines between words so they stay inside that many pixels, '\n' always breaks
+        SDL_Point measure(std::string_view text, int wrapWidth = 0) const;
+        void draw(RenderQueue& queue, RenderLayer layer, std::string_view text, int x, int y, SDL_Color color, int wrapWidth = 0) const;
+
+        int getLineHeight() const { return lineSkip; }
+        SDL_Texture* getTexture() const { return texture; }
+
+    private:
+        static const int FirstGlyph = ' ';
+        static const int LastGlyph = '~';
+        static const int GlyphCount = LastGlyph - FirstGlyph + 1;
+
+        struct Glyph {
+            SDL_Rect src{ 0, 0, 0, 0 }; // Empty for glyphs with no ink, like space
+            int advance = 0;
+        };
+
+        static int glyphIndex(char c);
+        int kerning(int previous, int current) const;
+        int wordWidth(std::string_view word) const;
+        template <typename Fn>
+        void layout(std::string_view text, int wrapWidth, Fn&& emit) const;
+
+        SDL_Texture* texture = nullptr;
+        std::array<Glyph, GlyphCount> glyphs;
+        std::vector<signed char> kerningTable; // GlyphCount * GlyphCount, [previous * GlyphCount + current]
+        int fontHeight = 0;
+        int lineSkip = 0;
+};
+
+# endif
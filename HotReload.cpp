@@ -0,0 +1,252 @@
+// Includes
+# include "HotReload.hpp"
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include "TextParser.hpp"
+# include "ContentPack.hpp"
+# include <iostream>
+# include <algorithm>
+# ifdef __linux__
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#  include <cerrno>
+# endif
+
+// General Functions
+static const char* separatorFor(bool isNPC) { return isNPC ? "----------" : "-----------"; }
+
+template <typename Fn>
+static void forEachBlock(std::string_view buffer, bool isNPC, Fn&& fn) { // fn(block text, line number of its first line)
+    TextScanner scanner(buffer);
+    std::vector<TextLine> lines;
+
+    while (scanner.nextBlock(separatorFor(isNPC), lines)) {
+        const char* start = lines.front().text.data();
+        const char* end = lines.back().text.data() + lines.back().text.size();
+        fn(std::string_view(start, static_cast<size_t>(end - start)), lines.front().number);
+    }
+}
+static void reportBlockDiagnostics(const std::string& path, int firstLine, std::vector<ParseDiagnostic>& diagnostics) {
+    for (auto& d : diagnostics) d.line += firstLine - 1;
+    reportDiagnostics(path, diagnostics);
+}
+
+// FileWatcher Functions
+FileWatcher::FileWatcher() {
+# ifdef __linux__
+    inotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFD < 0) std::cerr << "inotify unavailable, polling content files instead\n";
+# endif
+}
+FileWatcher::~FileWatcher() {
+# ifdef __linux__
+    if (inotifyFD >= 0) close(inotifyFD);
+# endif
+}
+bool FileWatcher::watch(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    Watched w;
+    w.path = path;
+    w.directory = fs::absolute(path, ec).parent_path();
+    w.filename = fs::path(path).filename().string();
+    w.modified = fs::last_write_time(path, ec);
+    if (ec) {
+        std::cerr << "Cannot watch " << path << ": " << ec.message() << "\n";
+        return false;
+    }
+
+# ifdef __linux__
+    // Watch the directory rather than the file, editors often save by writing a new file and renaming it over the old one
+    if (inotifyFD >= 0) {
+        bool watched = std::any_of(directoryWatches.begin(), directoryWatches.end(),
+                                   [&](const auto& pair) { return pair.second == w.directory; });
+        if (!watched) {
+            int wd = inotify_add_watch(inotifyFD, w.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (wd < 0) {
+                std::cerr << "Cannot watch " << w.directory << ", polling instead\n";
+                close(inotifyFD);
+                inotifyFD = -1;
+            } else {
+                directoryWatches[wd] = w.directory;
+            }
+        }
+    }
+# endif
+
+    files.push_back(std::move(w));
+    return true;
+}
+std::vector<std::string> FileWatcher::poll() {
+    std::vector<std::string> changed;
+    auto markChanged = [&](const Watched& w) {
+        if (std::find(changed.begin(), changed.end(), w.path) == changed.end()) changed.push_back(w.path);
+    };
+
+# ifdef __linux__
+    if (inotifyFD >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t length = read(inotifyFD, buffer, sizeof(buffer));
+            if (length <= 0) break; // EAGAIN, nothing left this frame
+
+            for (char* at = buffer; at < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                at += sizeof(inotify_event) + event->len;
+
+                auto dir = directoryWatches.find(event->wd);
+                if (dir == directoryWatches.end() || event->len == 0) continue;
+
+                for (const auto& w : files) {
+                    if (w.directory == dir->second && w.filename == event->name) markChanged(w);
+                }
+            }
+        }
+        return changed;
+    }
+# endif
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastScan < std::chrono::milliseconds(250)) return changed;
+    lastScan = now;
+
+    for (auto& w : files) {
+        std::error_code ec;
+        auto modified = std::filesystem::last_write_time(w.path, ec);
+        if (ec || modified == w.modified) continue; // Mid-save files can briefly vanish, catch them next scan
+
+        w.modified = modified;
+        markChanged(w);
+    }
+    return changed;
+}
+
+// ContentHotReload Functions
+ContentHotReload::ContentHotReload(ItemFactory& itemfactory, std::unordered_map<int, std::unique_ptr<NPC>>& npcs)
+    : itemfactory(itemfactory), npcs(npcs) {}
+void ContentHotReload::setPackContent(const ContentPack& pack) {
+    packItemIDs = pack.itemIDs;
+    packNPCIDs = pack.npcIDs;
+}
+void ContentHotReload::watchItems(const std::string& path) { watchSource(path, false); }
+void ContentHotReload::watchNPCs(const std::string& path) { watchSource(path, true); }
+void ContentHotReload::watchSource(const std::string& path, bool isNPC) {
+    Source source;
+    source.path = path;
+    source.isNPC = isNPC;
+
+    std::string buffer;
+    if (readTextFile(path, buffer)) {
+        forEachBlock(buffer, isNPC, [&](std::string_view text, int) {
+            source.blockHashes.insert(std::hash<std::string_view>()(text));
+        });
+    }
+
+    if (watcher.watch(path)) sources.push_back(std::move(source));
+}
+HotReloadResult ContentHotReload::update() {
+    HotReloadResult result;
+
+    for (const std::string& path : watcher.poll()) {
+        for (auto& source : sources) {
+            if (source.path == path) reload(source, result);
+        }
+    }
+
+    return result;
+}
+void ContentHotReload::reload(Source& source, HotReloadResult& result) {
+    std::string buffer;
+    if (!readTextFile(source.path, buffer)) return; // Half saved, the next event picks it up
+
+    std::unordered_set<size_t> hashes;
+    hashes.reserve(source.blockHashes.size());
+    int changed = 0;
+
+    forEachBlock(buffer, source.isNPC, [&](std::string_view text, int firstLine) {
+        size_t hash = std::hash<std::string_view>()(text);
+        hashes.insert(hash);
+        if (source.blockHashes.count(hash)) return; // Untouched block
+
+        changed++;
+        if (source.isNPC) applyNPCBlock(text, firstLine, source.path, result);
+        else applyItemBlock(text, firstLine, source.path, result);
+    });
+
+    source.blockHashes = std::move(hashes);
+    result.changedBlocks += changed;
+
+    if (changed > 0) std::cout << "Reloaded " << source.path << ": " << changed << " changed block" << (changed == 1 ? "\n" : "s\n");
+}
+void ContentHotReload::applyItemBlock(std::string_view text, int firstLine, const std::string& path, HotReloadResult& result) {
+    std::vector<ParseDiagnostic> diagnostics;
+    auto defs = ItemFactory::parseItems(text, diagnostics);
+    reportBlockDiagnostics(path, firstLine, diagnostics);
+    if (defs.empty()) result.skipped++;
+
+    ItemRegistry& registry = itemfactory.getRegistry();
+    for (auto& def : defs) {
+        if (packItemIDs.count(def->ItemID)) {
+            std::cerr << path << ":" << firstLine << ": item " << def->ItemID << " is defined by the content pack, edit it there\n";
+            result.skipped++;
+            continue;
+        }
+
+        const ItemDefinition* existing = registry.find(def->ItemID);
+
+        // Live items were built as one class, a different kind would need a different object
+        if (existing && existing->Kind != def->Kind) {
+            std::cerr << path << ":" << firstLine << ": item " << def->ItemID << " changed kind, restart to apply\n";
+            result.skipped++;
+            continue;
+        }
+
+        registry.add(std::move(def));
+        if (existing) result.patchedItems++;
+        else result.addedItems++;
+    }
+}
+void ContentHotReload::applyNPCBlock(std::string_view text, int firstLine, const std::string& path, HotReloadResult& result) {
+    std::vector<ParseDiagnostic> diagnostics;
+    auto parsed = NPCFactory::parseNPCs(text, diagnostics);
+    reportBlockDiagnostics(path, firstLine, diagnostics);
+    if (parsed.empty()) result.skipped++;
+
+    for (auto& npc : parsed) {
+        if (packNPCIDs.count(npc->getID())) {
+            std::cerr << path << ":" << firstLine << ": NPC " << npc->getID() << " is defined by the content pack, edit it there\n";
+            result.skipped++;
+            continue;
+        }
+
+        auto it = npcs.find(npc->getID());
+        if (it == npcs.end()) {
+            int id = npc->getID();
+            npcs[id] = std::move(npc);
+            result.addedNPCs++;
+            continue;
+        }
+
+        // Patch through the setters, combat and the map hold pointers to the existing NPC
+        NPC* existing = it->second.get();
+        if (existing->getType() != npc->getType()) {
+            std::cerr << path << ":" << firstLine << ": NPC " << npc->getID() << " changed type, restart to apply\n";
+            result.skipped++;
+            continue;
+        }
+
+        existing->setName(npc->getName());
+        existing->setHealth(npc->getHealth());
+        if (EnemyNPC* enemy = dynamic_cast<EnemyNPC*>(existing)) {
+            enemy->setAttack(npc->getAttack());
+            enemy->setDefense(npc->getDefense());
+            enemy->setXP(npc->getXP());
+            enemy->setGold(npc->getGold());
+        }
+        else if (FriendlyNPC* friendly = dynamic_cast<FriendlyNPC*>(existing)) {
+            friendly->setJob(static_cast<FriendlyNPC*>(npc.get())->getJob());
+        }
+        result.patchedNPCs++;
+    }
+}
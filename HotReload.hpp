@@ -0,0 +1,91 @@
+# ifndef HOTRELOAD_HPP
+# define HOTRELOAD_HPP
+
+# include <string>
+# include <vector>
+# include <memory>
+# include <chrono>
+# include <filesystem>
+# include <unordered_map>
+# include <unordered_set>
+
+// Live content editing: watches the text files and re-parses only the blocks that changed.
+// Definitions are patched in place through ItemRegistry::add, so live Items keep their pointers and pick up the new stats.
+// Edits that would need a different Item class (a potion turning into a weapon) are skipped until the next restart,
+// and deleting a block leaves its definition alone since items may still point at it.
+// IDs a content pack defines are skipped too, the pack's definition wins over the base files (ContentPack.hpp).
+
+// Class Declarations
+class ItemFactory;
+class NPC;
+struct ContentPack;
+
+// Structures
+struct HotReloadResult {
+    int changedBlocks = 0;
+    int patchedItems = 0;
+    int addedItems = 0;
+    int patchedNPCs = 0;
+    int addedNPCs = 0;
+    int skipped = 0; // Kind or NPC type changes, IDs a content pack owns and blocks that failed to parse
+
+    bool changed() const { return patchedItems + addedItems + patchedNPCs + addedNPCs > 0; }
+};
+
+// Classes
+class FileWatcher {
+    public:
+        FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+        ~FileWatcher();
+
+        bool watch(const std::string& path);
+        std::vector<std::string> poll(); // Never blocks, returns each watched path that changed since the last call once
+
+    private:
+        struct Watched {
+            std::string path;
+            std::filesystem::path directory;
+            std::string filename;
+            std::filesystem::file_time_type modified;
+        };
+
+        std::vector<Watched> files;
+        std::chrono::steady_clock::time_point lastScan; // Polling fallback only looks at the disk a few times a second
+        int inotifyFD = -1; // Linux only, -1 means the polling fallback is in use
+        std::unordered_map<int, std::filesystem::path> directoryWatches; // inotify watch descriptor -> directory
+};
+class ContentHotReload {
+    public:
+        ContentHotReload(ItemFactory& itemfactory, std::unordered_map<int, std::unique_ptr<NPC>>& npcs);
+
+        void setPackContent(const ContentPack& pack); // Leave the IDs the pack defines alone
+
+        // Snapshots the file as it is now, so only later edits count as changes
+        void watchItems(const std::string& path);
+        void watchNPCs(const std::string& path);
+
+        HotReloadResult update(); // Call once a frame
+
+    private:
+        struct Source {
+            std::string path;
+            bool isNPC;
+            std::unordered_set<size_t> blockHashes;
+        };
+
+        void watchSource(const std::string& path, bool isNPC);
+        void reload(Source& source, HotReloadResult& result);
+        void applyItemBlock(std::string_view text, int firstLine, const std::string& path, HotReloadResult& result);
+        void applyNPCBlock(std::string_view text, int firstLine, const std::string& path, HotReloadResult& result);
+
+        ItemFactory& itemfactory;
+        std::unordered_map<int, std::unique_ptr<NPC>>& npcs;
+        std::unordered_set<int> packItemIDs;
+        std::unordered_set<int> packNPCIDs;
+        std::vector<Source> sources;
+        FileWatcher watcher;
+};
+
+# endif
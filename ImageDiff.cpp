@@ -0,0 +1,101 @@
+// Includes
+# include "ImageDiff.hpp"
+# include <SDL2/SDL_image.h>
+# include <algorithm>
+# include <cstdlib>
+
+// ARGB8888 copy with rows locked for reading, or nullptr
+static SDL_Surface* toARGB(SDL_Surface* surface) {
+    if (!surface) return nullptr;
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (converted && SDL_LockSurface(converted) != 0) {
+        SDL_FreeSurface(converted);
+        return nullptr;
+    }
+    return converted;
+}
+static void release(SDL_Surface* surface) {
+    if (!surface) return;
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+}
+static const Uint32* row(SDL_Surface* surface, int y) {
+    return reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) + y * surface->pitch);
+}
+static int channelDelta(Uint32 a, Uint32 b) {
+    int delta = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        delta = std::max(delta, std::abs(static_cast<int>((a >> shift) & 0xFF) - static_cast<int>((b >> shift) & 0xFF)));
+    }
+    return delta;
+}
+
+// Functions
+ImageDiff diffImages(SDL_Surface* actual, SDL_Surface* expected, int tolerance) {
+    ImageDiff diff;
+    SDL_Surface* a = toARGB(actual);
+    SDL_Surface* b = toARGB(expected);
+    if (!a || !b || a->w != b->w || a->h != b->h) {
+        release(a);
+        release(b);
+        return diff;
+    }
+    diff.sizeMatches = true;
+
+    int minX = a->w, minY = a->h, maxX = -1, maxY = -1;
+    for (int y = 0; y < a->h; y++) {
+        const Uint32* rowA = row(a, y);
+        const Uint32* rowB = row(b, y);
+        for (int x = 0; x < a->w; x++) {
+            if (rowA[x] == rowB[x]) continue;
+
+            int delta = channelDelta(rowA[x], rowB[x]);
+            diff.maxDelta = std::max(diff.maxDelta, delta);
+            if (delta <= tolerance) continue;
+
+            diff.differentPixels++;
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+    }
+    if (diff.differentPixels > 0) diff.bounds = { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+
+    release(a);
+    release(b);
+    return diff;
+}
+SDL_Surface* makeDiffImage(SDL_Surface* actual, SDL_Surface* expected, int tolerance) {
+    SDL_Surface* a = toARGB(actual);
+    SDL_Surface* b = toARGB(expected);
+    SDL_Surface* out = nullptr;
+    if (a && b && a->w == b->w && a->h == b->h) out = SDL_CreateRGBSurfaceWithFormat(0, a->w, a->h, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    if (out && SDL_LockSurface(out) == 0) {
+        for (int y = 0; y < a->h; y++) {
+            const Uint32* rowA = row(a, y);
+            const Uint32* rowB = row(b, y);
+            Uint32* dst = reinterpret_cast<Uint32*>(static_cast<Uint8*>(out->pixels) + y * out->pitch);
+            for (int x = 0; x < a->w; x++) {
+                if (channelDelta(rowA[x], rowB[x]) > tolerance) {
+                    dst[x] = 0xFFFF0000;
+                } else {
+                    Uint32 p = rowB[x]; // Quarter brightness, so the red stands out
+                    dst[x] = 0xFF000000 | ((p >> 2) & 0x3F3F3F);
+                }
+            }
+        }
+        SDL_UnlockSurface(out);
+    }
+
+    release(a);
+    release(b);
+    return out;
+}
+bool saveImage(SDL_Surface* surface, const std::string& path) {
+    return surface && IMG_SavePNG(surface, path.c_str()) == 0;
+}
+SDL_Surface* loadImage(const std::string& path) {
+    return IMG_Load(path.c_str());
+}
@@ -0,0 +1,26 @@
+# ifndef IMAGEDIFF_HPP
+# define IMAGEDIFF_HPP
+
+# include <string>
+# include <SDL2/SDL.h>
+
+// Pixel comparison for golden-image checks of headless frames. Both images are compared as ARGB8888,
+// so a PNG that loads back in another format still matches the frame it was saved from.
+
+// Structures
+struct ImageDiff {
+    bool sizeMatches = false;
+    long long differentPixels = 0; // Pixels with some channel off by more than the tolerance
+    int maxDelta = 0; // Largest difference in any one channel, over all pixels
+    SDL_Rect bounds{ 0, 0, 0, 0 }; // Around every differing pixel
+
+    bool matches() const { return sizeMatches && differentPixels == 0; }
+};
+
+// Functions
+ImageDiff diffImages(SDL_Surface* actual, SDL_Surface* expected, int tolerance = 0);
+SDL_Surface* makeDiffImage(SDL_Surface* actual, SDL_Surface* expected, int tolerance = 0); // Expected dimmed, differing pixels red; caller frees
+bool saveImage(SDL_Surface* surface, const std::string& path); // PNG
+SDL_Surface* loadImage(const std::string& path); // Caller frees, nullptr if missing
+
+# endif
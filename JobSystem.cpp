@@ -0,0 +1,158 @@
+// Includes
+# include "JobSystem.hpp"
+
+// General Functions
+static thread_local const JobSystem* slotOwner = nullptr; // Set on worker threads only
+static thread_local int slotIndex = 0;
+static thread_local unsigned stealSeed = 0;
+
+JobSystem& jobSystem() {
+    static JobSystem instance;
+    return instance;
+}
+
+// JobSystem Functions
+JobSystem::JobSystem(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int t = 0; t < threads; ++t) workers.push_back(std::make_unique<Worker>());
+    statsStart = nowNs();
+    for (int t = 1; t < threads; ++t) workers[t]->thread = std::thread(&JobSystem::workerLoop, this, t);
+}
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+
+    // Whatever the workers left, and with one thread there are no workers to run what slot 0 never waited on
+    Job job;
+    while (takeJob(0, job)) execute(0, job);
+}
+long long JobSystem::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+int JobSystem::currentSlot() const {
+    return slotOwner == this ? slotIndex : 0;
+}
+void JobSystem::submit(const Job& job) {
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Worker& target = *workers[currentSlot()];
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.jobs.push_back(job);
+    }
+
+    // Both sides are sequentially consistent: either this sees the sleeper, or the sleeper sees the job
+    queued.fetch_add(1);
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+bool JobSystem::takeJob(int slot, Job& job) {
+    Worker& own = *workers[slot];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest job from someone else, starting at a random deque so thieves spread out
+    int count = getThreadCount();
+    if (count == 1 || queued.load(std::memory_order_relaxed) <= 0) return false;
+
+    stealSeed = stealSeed * 1664525u + 1013904223u;
+    int start = static_cast<int>((stealSeed >> 16) % static_cast<unsigned>(count));
+    for (int i = 0; i < count; ++i) {
+        int victim = (start + i) % count;
+        if (victim == slot) continue;
+
+        Worker& other = *workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (other.jobs.empty()) continue;
+
+        job = other.jobs.front();
+        other.jobs.pop_front();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        own.stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+void JobSystem::execute(int slot, Job& job) {
+    if (job.dependency) wait(*job.dependency);
+    job.invoke(job);
+
+    workers[slot]->executed.fetch_add(1, std::memory_order_relaxed);
+    job.counter->pending.fetch_sub(1, std::memory_order_release); // Publishes the job's writes to whoever waits
+}
+void JobSystem::wait(const JobCounter& counter) {
+    int slot = currentSlot();
+    bool worker = slotOwner == this; // Workers already count this time in workerLoop
+
+    Job job;
+    while (!counter.isDone()) {
+        if (!takeJob(slot, job)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        long long start = worker ? 0 : nowNs();
+        execute(slot, job);
+        if (!worker) workers[slot]->busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+    }
+}
+void JobSystem::workerLoop(int slot) {
+    slotOwner = this;
+    slotIndex = slot;
+    stealSeed = static_cast<unsigned>(slot) * 2654435761u;
+    Worker& self = *workers[slot];
+
+    for (;;) {
+        long long start = nowNs();
+        Job job;
+        while (takeJob(slot, job)) execute(slot, job);
+        self.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+
+        // Jobs tend to come in bursts, so spin a little before going to sleep
+        for (int i = 0; i < 64 && queued.load(std::memory_order_relaxed) <= 0; ++i) std::this_thread::yield();
+        if (queued.load(std::memory_order_relaxed) > 0) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping) return;
+        sleepers.fetch_add(1);
+        wake.wait(lock, [&] { return stopping || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+        if (stopping && queued.load() <= 0) return;
+    }
+}
+std::vector<WorkerStats> JobSystem::getStats() const {
+    double elapsedMs = (nowNs() - statsStart) / 1e6;
+
+    std::vector<WorkerStats> stats(workers.size());
+    for (size_t i = 0; i < workers.size(); ++i) {
+        stats[i].jobs = workers[i]->executed.load(std::memory_order_relaxed);
+        stats[i].steals = workers[i]->stolen.load(std::memory_order_relaxed);
+        stats[i].busyMs = workers[i]->busyNs.load(std::memory_order_relaxed) / 1e6;
+        stats[i].utilisation = elapsedMs > 0.0 ? std::min(1.0, stats[i].busyMs / elapsedMs) : 0.0;
+    }
+    return stats;
+}
+void JobSystem::resetStats() {
+    for (auto& w : workers) {
+        w->executed.store(0, std::memory_order_relaxed);
+        w->stolen.store(0, std::memory_order_relaxed);
+        w->busyNs.store(0, std::memory_order_relaxed);
+    }
+    statsStart = nowNs();
+}
@@ -0,0 +1,134 @@
+# ifndef JOBSYSTEM_HPP
+# define JOBSYSTEM_HPP
+
+# include <algorithm>
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <cstring>
+# include <deque>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <vector>
+
+// Engine-wide job system. One worker thread per core, each with its own deque: a worker pushes and pops at the
+// back of its own deque (newest first, still in cache) and steals from the front of the others when it runs dry.
+// Threads that aren't workers share slot 0 and run jobs while they wait(), so the main thread is a worker too.
+// A job is a function pointer plus a small copy of the lambda, submitting one never allocates.
+//
+// Counters track groups of jobs: run() adds one, the job finishing takes it away and wait() returns at zero.
+// A job can also depend on a counter, it waits (running other jobs) for that counter before it starts.
+// Blocking file reads stay on their own streamer threads (AssetStreamer, ChunkStreamer) so they never hold up a worker.
+
+// Structures
+class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending{ 0 };
+};
+
+struct WorkerStats { // Since the last resetStats()
+    long long jobs = 0;
+    long long steals = 0; // Of those, how many were taken from another deque
+    double busyMs = 0.0; // Running jobs; workers also count looking for the next, slot 0 only jobs it took in wait()
+    double utilisation = 0.0; // busyMs over the time since the reset
+};
+
+// Classes
+class JobSystem {
+    public:
+        static const int PayloadBytes = 40; // Lambda captures, keeps a job at one cache line
+
+        explicit JobSystem(int threads = 0); // Counting the caller's slot; threads <= 0 uses every core
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        ~JobSystem(); // Joins the workers, then runs anything still queued on the calling thread
+
+        // fn() runs on some worker. It is copied as bytes, so capture references and pointers, not strings
+        template <typename Fn>
+        void run(JobCounter& counter, const Fn& fn) { run(counter, nullptr, fn); }
+        template <typename Fn>
+        void run(JobCounter& counter, const JobCounter* dependency, const Fn& fn) {
+            static_assert(sizeof(Fn) <= PayloadBytes, "Capture less, or capture a pointer to the state");
+            static_assert(alignof(Fn) <= alignof(void*), "Over-aligned capture");
+            static_assert(std::is_trivially_copyable<Fn>::value, "Jobs are copied as bytes, capture by reference");
+
+            Job job;
+            job.invoke = [](Job& j) { (*reinterpret_cast<Fn*>(j.payload))(); };
+            job.counter = &counter;
+            job.dependency = dependency;
+            std::memcpy(job.payload, &fn, sizeof(Fn));
+            submit(job);
+        }
+        void wait(const JobCounter& counter); // Runs jobs until counter reaches zero
+
+        // fn(first, last) over [begin, end) in pieces of about grain, returns when all are done; grain <= 0 picks one
+        template <typename Fn>
+        void parallelFor(int begin, int end, int grain, const Fn& fn) {
+            int count = end - begin;
+            if (count <= 0) return;
+            if (grain <= 0) grain = std::max(1, count / (getThreadCount() * 4)); // A few pieces per thread to even out
+            if (count <= grain || getThreadCount() == 1) {
+                fn(begin, end);
+                return;
+            }
+
+            JobCounter counter;
+            const Fn* body = &fn;
+            for (int first = begin + grain; first < end; first += grain) {
+                int last = std::min(end, first + grain);
+                run(counter, [body, first, last] { (*body)(first, last); });
+            }
+            fn(begin, begin + grain); // The first piece here, the rest are already being stolen
+            wait(counter);
+        }
+
+        int getThreadCount() const { return static_cast<int>(workers.size()); }
+        std::vector<WorkerStats> getStats() const; // Slot 0 first
+        void resetStats();
+
+    private:
+        struct Job {
+            void (*invoke)(Job&) = nullptr;
+            JobCounter* counter = nullptr;
+            const JobCounter* dependency = nullptr;
+            alignas(void*) unsigned char payload[PayloadBytes];
+        };
+        struct alignas(64) Worker { // Own cache line, the counters are written on every job
+            std::mutex mutex; // Guards jobs
+            std::deque<Job> jobs;
+            std::thread thread;
+            std::atomic<long long> executed{ 0 };
+            std::atomic<long long> stolen{ 0 };
+            std::atomic<long long> busyNs{ 0 };
+        };
+
+        void submit(const Job& job);
+        bool takeJob(int slot, Job& job); // Own deque, then steal
+        void execute(int slot, Job& job);
+        void workerLoop(int slot);
+        int currentSlot() const;
+        static long long nowNs();
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<int> queued{ 0 }; // Jobs sitting in deques
+        std::atomic<int> sleepers{ 0 };
+        std::mutex sleepMutex; // Guards stopping, pairs with wake
+        std::condition_variable wake;
+        bool stopping = false;
+        long long statsStart = 0;
+};
+
+// Functions
+JobSystem& jobSystem(); // The engine's one job system, started on first use with a worker per core
+
+# endif
@@ -1,16 +1,14 @@
 // Includes
 # include "NPCs.hpp"
+# include "GameData.hpp"
 # include <iostream>
 # include <fstream>
 # include <memory>
 # include <unordered_map>
 
 // General Functions for shit to work
-static inline std::string trim(const std::string& s) {
-	size_t start = s.find_first_not_of(" \t\r\n");
-	if (start == std::string::npos) return "";
-	size_t end = s.find_last_not_of(" \t\r\n");
-	return s.substr(start, end - start + 1);
+static inline std::string_view trim(std::string_view s) {
+	return trimView(s, " \t\r\n");
 }
 
 // Friendly Functions
@@ -48,43 +46,74 @@ void EnemyNPC::interact() {
 // NPCFactory Functions
 std::unordered_map<int, std::unique_ptr<NPC>> NPCFactory::loadNPCs(const std::string& filename) {
     std::unordered_map<int, std::unique_ptr<NPC>> npcs;
-    std::ifstream file(filename);
+    std::string buffer;
+    diagnostics.clear();
     
-    if (!file) {
+    if (!readTextFile(filename, buffer)) {
         std::cerr << "Failed to open NPC file: " << filename << "\n";
         return npcs;
     }
     
-    std::vector<std::string> block;
-    std::string line;
+    auto parsed = parseNPCs(buffer, diagnostics);
+    npcs.reserve(parsed.size());
+    for (auto& npc : parsed) {
+        int id = npc->getID();
+		npcs[id] = std::move(npc);
+    }
     
-    while (std::getline(file, line)) {
-        if(line.find("----------") != std::string::npos) {
-            if (!block.empty()) {
-                auto npc = parseNPCBlock(block);
-                if (npc) {
-                    int id = npc->getID();
-					npcs[id] = std::move(npc);
-                }
-                block.clear();
-            }
-        } else if (!line.empty()) {
-            block.push_back(line);
-        }
+    reportDiagnostics(filename, diagnostics);
+    return npcs;
+}
+const std::vector<ParseDiagnostic>& NPCFactory::getDiagnostics() const { return diagnostics; }
+std::vector<std::unique_ptr<NPC>> NPCFactory::parseNPCs(std::string_view text, std::vector<ParseDiagnostic>& diagnostics) {
+    std::vector<std::unique_ptr<NPC>> npcs;
+    npcs.reserve(countBlocks(text, "----------"));
+    
+    TextScanner scanner(text);
+    std::vector<TextLine> block;
+    
+    while (scanner.nextBlock("----------", block)) {
+        auto npc = parseNPCBlock(block, diagnostics);
+        if (npc) npcs.push_back(std::move(npc));
     }
-    if (!block.empty()) {
-        auto npc = parseNPCBlock(block);
-        if (npc) {
-            int id = npc->getID();
-			npcs[id] = std::move(npc);
+    
+    return npcs;
+}
+std::unordered_map<int, std::unique_ptr<NPC>> NPCFactory::loadNPCs(const GameDataFile& data) {
+    std::unordered_map<int, std::unique_ptr<NPC>> npcs;
+    npcs.reserve(data.getNPCCount());
+
+    for (int i = 0; i < data.getNPCCount(); ++i) {
+        const NPCRecord& r = data.getNPC(i);
+        std::string name(data.getString(r.nameOffset, r.nameLength));
+
+        if (static_cast<NPCType>(r.type) == NPCType::Enemy) {
+            auto npc = std::make_unique<EnemyNPC>();
+            npc->setID(r.id);
+            npc->setName(name);
+            npc->setHealth(r.health);
+            npc->setAttack(r.attack);
+            npc->setDefense(r.defense);
+            npc->setXP(r.xp);
+            npc->setGold(r.gold);
+            npc->setType(NPCType::Enemy);
+            npcs[r.id] = std::move(npc);
+        } else {
+            auto npc = std::make_unique<FriendlyNPC>();
+            npc->setID(r.id);
+            npc->setName(name);
+            npc->setHealth(r.health);
+            npc->setJob(static_cast<FriendlyJob>(r.job));
+            npc->setType(NPCType::Friendly);
+            npcs[r.id] = std::move(npc);
         }
     }
-    
+
     return npcs;
 }
-std::unique_ptr<NPC> NPCFactory::parseNPCBlock(const std::vector<std::string>& lines) {
+std::unique_ptr<NPC> NPCFactory::parseNPCBlock(const std::vector<TextLine>& lines, std::vector<ParseDiagnostic>& diagnostics) {
     int id = 0;
-    std::string name = "Unknown";
+    std::string_view name = "Unknown";
     int health = 0;
     int xp = 0;
     
@@ -99,36 +128,37 @@ std::unique_ptr<NPC> NPCFactory::parseNPCBlock(const std::vector<std::string>& l
     NPCType type = NPCType::Friendly; // Defaults to friendly
     
     { // ID - Name
-        std::string header = trim(lines[0]);
+        std::string_view header = trim(lines[0].text);
         auto dash = header.find('-');
-        if (dash != std::string::npos) {
-            id = std::stoi(header.substr(0, dash));
+        if (dash != std::string_view::npos) {
+            if (!parseInt(lines[0], header.substr(0, dash), id, diagnostics)) return nullptr;
             name = trim(header.substr(dash + 1));
-            name.erase(0, name.find_first_not_of(" \t"));
+        } else {
+            diagnostics.push_back({ lines[0].number, columnOf(lines[0], header), "expected 'ID - Name'" });
         }
     }
     
     // Remaining Information
     for (size_t i = 1; i < lines.size(); ++i) {
-        std::string line = trim(lines[i]);
+        std::string_view line = trim(lines[i].text);
         if (line.empty()) continue;
         
         auto colon = line.find(':');
-        if (colon == std::string::npos)
+        if (colon == std::string_view::npos)
             continue;
         
-        std::string key = trim(line.substr(0, colon));
-		std::string value = trim(line.substr(colon + 1));
+        std::string_view key = trim(line.substr(0, colon));
+		std::string_view value = trim(line.substr(colon + 1));
         
         if (key == "Type") {
             if (value == "Enemy") type = NPCType::Enemy;
             else if (value == "Friendly") type = NPCType::Friendly;
         }
-        else if (key == "Health") health = std::stoi(value);
-        else if (key == "XP") xp = std::stoi(value);
-        else if (key == "Damage") damage = std::stoi(value);
-        else if (key == "Defense") defense = std::stoi(value);
-		else if (key == "Gold") gold = std::stoi(value);
+        else if (key == "Health") parseInt(lines[i], value, health, diagnostics);
+        else if (key == "XP") parseInt(lines[i], value, xp, diagnostics);
+        else if (key == "Damage") parseInt(lines[i], value, damage, diagnostics);
+        else if (key == "Defense") parseInt(lines[i], value, defense, diagnostics);
+		else if (key == "Gold") parseInt(lines[i], value, gold, diagnostics);
         else if (key == "Job") {
             if (value == "Shop") job = FriendlyJob::Shop;
             else if (value == "Quest") job = FriendlyJob::Quest;
@@ -139,18 +169,19 @@ std::unique_ptr<NPC> NPCFactory::parseNPCBlock(const std::vector<std::string>& l
     if (type == NPCType::Enemy) {
         auto npc = std::make_unique<EnemyNPC>();
         npc->setID(id);
-        npc->setName(name);
+        npc->setName(std::string(name));
         npc->setHealth(health);
         npc->setAttack(damage);
         npc->setDefense(defense);
         npc->setXP(xp);
+        npc->setGold(gold);
         npc->setType(NPCType::Enemy);
         return npc;
     }
     
     auto npc = std::make_unique<FriendlyNPC>();
     npc->setID(id);
-    npc->setName(name);
+    npc->setName(std::string(name));
     npc->setHealth(health);
     npc->setJob(job);
     npc->setType(NPCType::Friendly);
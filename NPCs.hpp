@@ -5,8 +5,10 @@
 # include <vector>
 # include <memory>
 # include <unordered_map>
+# include "TextParser.hpp"
 
 // Class Declarations
+class GameDataFile;
 enum class FriendlyJob {
 	Shop,
 	Quest
@@ -34,8 +36,8 @@ class NPC {
 		
 		virtual int getAttack() const { return 0; };
 		virtual int getDefense() const { return 0; };
-		virtual getXP() const { return 0; };
-		virtual getGold() const { return 0; };
+		virtual int getXP() const { return 0; };
+		virtual int getGold() const { return 0; };
     
     protected:
         NPCType type;
@@ -96,9 +98,15 @@ class EnemyNPC : public NPC {
 class NPCFactory {
 	public:
 		std::unordered_map<int, std::unique_ptr<NPC>> loadNPCs(const std::string& filename);
+		std::unordered_map<int, std::unique_ptr<NPC>> loadNPCs(const GameDataFile& data); // Compiled GameData.bin, no parsing
+		const std::vector<ParseDiagnostic>& getDiagnostics() const; // From the last text load, also printed to std::cerr
+		
+		// Parses in file order without any shared state, safe to call from several threads at once
+		static std::vector<std::unique_ptr<NPC>> parseNPCs(std::string_view text, std::vector<ParseDiagnostic>& diagnostics);
 	
 	private:
-	    std::unique_ptr<NPC> parseNPCBlock(const std::vector<std::string>& lines);
+	    std::vector<ParseDiagnostic> diagnostics;
+	    static std::unique_ptr<NPC> parseNPCBlock(const std::vector<TextLine>& lines, std::vector<ParseDiagnostic>& diagnostics);
 };
 
 # endif
\ No newline at end of file
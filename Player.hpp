@@ -0,0 +1,150 @@
+# ifndef PLAYER_HPP
+# define PLAYER_HPP
+
+# include <cmath>
+# include <algorithm>
+# include <vector>
+# include "RPG_Inventory_System.hpp"
+
+// Class Declarations
+class Player {
+    public:
+		static constexpr int MAX_LEVEL = 25;
+		
+        // Position
+        int x = 0;
+        int y = 0;
+        int spawnX = 0;
+        int spawnY = 0;
+        
+        // Stats
+        int health = 100;
+        int maxHealth = 100;
+		int Defense = 0;
+        int gold = 0;
+        int xp = 0;
+        int level = 0;
+        
+        // Leveling System
+        std::vector<int> xpThresholds;
+        
+        // Inventory
+        Inventory inventory;
+		unsigned statsVersion = ~0u; // Equipment version the stats were last derived from
+		int statsLevel = -1;
+        
+        // Constructor
+        Player() {
+            generateXPtable();
+        }
+        
+        // XP table generation
+        void generateXPtable() {
+            xpThresholds.clear();
+			xpThresholds.resize(MAX_LEVEL + 1);
+			
+            xpThresholds[0] = 0;
+			xpThresholds[1] = 10;
+            
+            for (int i = 1; i < MAX_LEVEL; ++i) {
+                int prev = xpThresholds[i];
+                int next = std::ceil(prev + std::log2(prev));
+                xpThresholds[i + 1] = next;
+            }
+        }
+        
+        // XP Gain
+        void addXP(int amount) {
+            xp += amount;
+            
+			if (level == MAX_LEVEL) {
+				xp = std::min(xp, xpThresholds[MAX_LEVEL]);
+			}
+			
+            while (level < MAX_LEVEL && xp >= xpThresholds[level + 1]) {
+                xp -= xpThresholds[level + 1];
+                level++;
+                onLevelUp();
+            }
+        }
+        
+        // Level Up Rewards
+        void onLevelUp() {
+            maxHealth += 10;
+            health = maxHealth;
+			if (level >= MAX_LEVEL) return;
+        }
+        
+        // Death Penalty
+        void applyDeathPenalty() {
+            // Reset and charge the player for death
+            xp = 0;
+            gold = std::max(0, gold - 100);
+            
+            // Spawn at the start
+			health = maxHealth;
+            x = spawnX;
+            y = spawnY;
+        }
+        
+        // Movement
+        void move(int dx, int dy) {
+            x += dx;
+            y += dy;
+        }
+		
+		// Finding Potion Slot for Battle Consumption
+		int findFirstPotionSlot() const {
+			for (int i = 0; i < inventory.getGeneralSlotCount(); ++i) {
+				const Item* it = inventory.getItem(i);
+				if (it && it->getKind() == ItemKind::Potion) {
+					return i;
+				}
+			}
+			return - 1;
+		}
+		
+		// Consuming Potion During Battle
+		bool consumePotion(int slot) {
+			Item* it = inventory.getItem(slot);
+			Potion* potion = it ? it->asPotion() : nullptr;
+			if (!potion) return false;
+			
+			ItemActionResult r = potion->use();
+			
+			if (r.success) {
+				health = std::min(maxHealth, health + r.healAmount);
+				inventory.removeFromStack(slot, 1);
+				
+				return true;
+			}
+			
+			return false;
+		}
+		
+		int getAttackDamage() const {
+			if (inventory.getEquippedWeapon()) return inventory.getStatBoosts().damage;
+			return 1; // Unarmed Damage
+		}
+		
+		void recalculateStats() {
+			// Nothing to do unless the gear or the level moved since last time
+			if (inventory.getEquipmentVersion() == statsVersion && level == statsLevel)
+				return;
+			statsVersion = inventory.getEquipmentVersion();
+			statsLevel = level;
+			
+			int baseHealth = 100 + level * 10;
+			int baseDefense = 0;
+			
+			const StatBoosts& boosts = inventory.getStatBoosts();
+			
+			maxHealth = baseHealth + boosts.health;
+			Defense = baseDefense + boosts.defense;
+			
+			if (health > maxHealth)
+				health = maxHealth;
+		}
+};
+
+# endif
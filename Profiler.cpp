@@ -0,0 +1,141 @@
+// Includes
+# include "Profiler.hpp"
+# include <algorithm>
+# include <fstream>
+# include <cstdio>
+
+// General Functions
+Profiler& profiler() {
+    static Profiler instance;
+    return instance;
+}
+
+// ProfileScope Functions
+ProfileScope::~ProfileScope() {
+    profiler().record(phase, SDL_GetPerformanceCounter() - start);
+}
+
+// Profiler Functions
+Profiler::Profiler() : history(HistoryFrames), frequency(std::max<Uint64>(1, SDL_GetPerformanceFrequency())) {}
+const char* Profiler::phaseName(ProfilePhase phase) {
+    static const char* names[PhaseCount] = {
+        "events", "explore", "inventory", "combat",
+        "drawBackdrop", "drawInventory", "drawSlot", "drawItem", "drawTooltip", "drawPlayerUI", "drawNPC", "drawPlayer", "drawText",
+        "present"
+    };
+    int index = static_cast<int>(phase);
+    return index >= 0 && index < PhaseCount ? names[index] : "?";
+}
+void Profiler::record(ProfilePhase phase, Uint64 ticks) {
+    Uint64 index = head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring[index & (RingSize - 1)];
+
+    slot.sequence.store(0, std::memory_order_relaxed); // Mark as being written
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.ticks.store(ticks, std::memory_order_relaxed);
+    slot.phase.store(static_cast<unsigned char>(phase), std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+void Profiler::endFrame(const FrameCounters& counters) {
+    FrameRecord& frame = history[frames % HistoryFrames];
+    frame = FrameRecord();
+    frame.counters = counters;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    frame.frameTicks = lastFrameEnd ? now - lastFrameEnd : 0;
+    lastFrameEnd = now;
+
+    // Drain. A slot still being written stops the drain until next frame; one already reused by a
+    // producer that lapped us is counted as lost
+    Uint64 end = head.load(std::memory_order_acquire);
+    if (end - tail > RingSize) {
+        dropped += end - tail - RingSize;
+        tail = end - RingSize;
+    }
+    while (tail < end) {
+        Slot& slot = ring[tail & (RingSize - 1)];
+        Uint64 sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence < tail + 1) break; // Not finished yet
+
+        Uint64 ticks = slot.ticks.load(std::memory_order_relaxed);
+        int phase = slot.phase.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != tail + 1) { // Overwritten while we read
+            dropped++;
+        } else if (phase < PhaseCount) {
+            frame.ticks[phase] += ticks;
+        }
+        tail++;
+    }
+
+    frames++;
+}
+PhaseSummary Profiler::summarizeTicks(std::vector<Uint64>& values) const {
+    PhaseSummary summary;
+    if (values.empty()) return summary;
+
+    std::sort(values.begin(), values.end());
+    Uint64 total = 0;
+    for (Uint64 v : values) total += v;
+
+    summary.minMs = toMs(values.front());
+    summary.avgMs = toMs(total) / values.size();
+    summary.p99Ms = toMs(values[std::min(values.size() - 1, values.size() * 99 / 100)]);
+    return summary;
+}
+PhaseSummary Profiler::summarize(ProfilePhase phase) const {
+    std::vector<Uint64> values;
+    long long count = std::min<long long>(frames, HistoryFrames);
+    values.reserve(count);
+    for (long long i = 0; i < count; ++i) values.push_back(history[i].ticks[static_cast<int>(phase)]);
+    return summarizeTicks(values);
+}
+PhaseSummary Profiler::summarizeFrame() const {
+    std::vector<Uint64> values;
+    long long count = std::min<long long>(frames, HistoryFrames);
+    for (long long i = 0; i < count; ++i) {
+        if (history[i].frameTicks) values.push_back(history[i].frameTicks);
+    }
+    return summarizeTicks(values);
+}
+const FrameCounters& Profiler::getLastCounters() const {
+    static const FrameCounters none;
+    return frames ? history[(frames - 1) % HistoryFrames].counters : none;
+}
+std::vector<std::string> Profiler::overlayLines() const {
+    std::vector<std::string> lines;
+    char line[96];
+
+    PhaseSummary total = summarizeFrame();
+    snprintf(line, sizeof(line), "frame          min %6.2f  avg %6.2f  p99 %6.2f ms", total.minMs, total.avgMs, total.p99Ms);
+    lines.push_back(line);
+
+    for (int i = 0; i < PhaseCount; ++i) {
+        PhaseSummary s = summarize(static_cast<ProfilePhase>(i));
+        snprintf(line, sizeof(line), "%-14s min %6.2f  avg %6.2f  p99 %6.2f", phaseName(static_cast<ProfilePhase>(i)), s.minMs, s.avgMs, s.p99Ms);
+        lines.push_back(line);
+    }
+
+    const FrameCounters& c = getLastCounters();
+    snprintf(line, sizeof(line), "%d draw calls, %d quads, %d texture changes, %d uploads", c.drawCalls, c.quads, c.textureChanges, c.textureUploads);
+    lines.push_back(line);
+    return lines;
+}
+bool Profiler::writeCSV(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "frame,frame_ms";
+    for (int i = 0; i < PhaseCount; ++i) out << "," << phaseName(static_cast<ProfilePhase>(i)) << "_ms";
+    out << ",draw_calls,quads,texture_changes,texture_uploads\n";
+
+    // Oldest kept frame first
+    long long first = std::max(0LL, frames - HistoryFrames);
+    for (long long f = first; f < frames; ++f) {
+        const FrameRecord& r = history[f % HistoryFrames];
+        out << f << "," << toMs(r.frameTicks);
+        for (Uint64 t : r.ticks) out << "," << toMs(t);
+        out << "," << r.counters.drawCalls << "," << r.counters.quads << "," << r.counters.textureChanges << "," << r.counters.textureUploads << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,114 @@
+# ifndef PROFILER_HPP
+# define PROFILER_HPP
+
+# include <array>
+# include <atomic>
+# include <string>
+# include <vector>
+# include <SDL2/SDL.h>
+
+// Frame profiler. PROFILE_SCOPE(phase) times the rest of the enclosing block and pushes the sample into a
+// fixed-size lock-free ring, so any thread can record without blocking. endFrame() runs on the main thread:
+// it drains the ring, sums each phase for the frame and keeps the last HistoryFrames frames for stats and CSV.
+
+// Structures
+enum class ProfilePhase : unsigned char {
+    Events,
+    Explore,
+    Inventory,
+    Combat,
+    DrawBackdrop,
+    DrawInventory,
+    DrawSlot,
+    DrawItem,
+    DrawTooltip,
+    DrawPlayerUI,
+    DrawNPC,
+    DrawPlayer,
+    DrawText,
+    Present,
+    Count
+};
+
+struct FrameCounters { // Per frame numbers that aren't times, passed in by whoever knows them
+    int drawCalls = 0;
+    int quads = 0;
+    int textureChanges = 0;
+    int textureUploads = 0;
+};
+
+struct PhaseSummary { // Over the kept history, milliseconds per frame
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p99Ms = 0.0;
+};
+
+// Classes
+class Profiler {
+    public:
+        static const int PhaseCount = static_cast<int>(ProfilePhase::Count);
+        static const int HistoryFrames = 300;
+
+        Profiler();
+
+        void record(ProfilePhase phase, Uint64 ticks); // Safe from any thread
+        void endFrame(const FrameCounters& counters);
+
+        PhaseSummary summarize(ProfilePhase phase) const;
+        PhaseSummary summarizeFrame() const; // Whole frames, end to end
+        const FrameCounters& getLastCounters() const;
+        std::vector<std::string> overlayLines() const;
+        bool writeCSV(const std::string& path) const;
+
+        long long getDroppedSamples() const { return dropped; }
+        static const char* phaseName(ProfilePhase phase);
+
+    private:
+        static const size_t RingSize = 4096; // Power of two
+
+        // Fields are atomics so a reader racing an overwrite gets a stale value, never a torn one
+        struct Slot {
+            std::atomic<Uint64> sequence{ 0 }; // Index + 1 once written
+            std::atomic<Uint64> ticks{ 0 };
+            std::atomic<unsigned char> phase{ 0 };
+        };
+        struct FrameRecord {
+            std::array<Uint64, PhaseCount> ticks{};
+            Uint64 frameTicks = 0;
+            FrameCounters counters;
+        };
+
+        double toMs(Uint64 ticks) const { return ticks * 1000.0 / frequency; }
+        PhaseSummary summarizeTicks(std::vector<Uint64>& values) const;
+
+        std::array<Slot, RingSize> ring;
+        std::atomic<Uint64> head{ 0 };
+        Uint64 tail = 0; // Main thread only
+
+        std::vector<FrameRecord> history; // Circular, HistoryFrames long
+        long long frames = 0;
+        long long dropped = 0;
+        Uint64 frequency;
+        Uint64 lastFrameEnd = 0;
+};
+
+class ProfileScope {
+    public:
+        explicit ProfileScope(ProfilePhase phase) : phase(phase), start(SDL_GetPerformanceCounter()) {}
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+        ~ProfileScope();
+
+    private:
+        ProfilePhase phase;
+        Uint64 start;
+};
+
+// Functions
+Profiler& profiler(); // The game's one profiler
+
+# define PROFILE_CONCAT_INNER(a, b) a##b
+# define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+# define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(phase)
+
+# endif
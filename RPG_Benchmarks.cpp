@@ -0,0 +1,719 @@
+// Microbenchmarks for the SDL-free game systems
+// Usage: bench [name ...]   (no names runs everything)
+
+// Includes
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <array>
+# include <memory>
+# include <chrono>
+# include <functional>
+# include <algorithm>
+# include <fstream>
+# include <filesystem>
+# include <unordered_map>
+# include <cmath>
+# include "RPG_Inventory_System.hpp"
+# include "NPCs.hpp"
+# include "GameData.hpp"
+# include "TextParser.hpp"
+# include "ContentPack.hpp"
+# include "RectPacker.hpp"
+# include "WorldEntities.hpp"
+# include "JobSystem.hpp"
+# include <thread>
+
+// Structures
+struct Benchmark {
+    const char* name;
+    std::function<void()> run;
+};
+
+// General Functions
+static volatile long long benchSink = 0; // Keeps results alive so loops don't get optimised out
+
+template <typename Fn>
+static double timeNsPerOp(long long ops, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+static void report(const char* label, double nsPerOp, double baseline = 0.0) {
+    std::cout << "  " << std::left << std::setw(44) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << nsPerOp << " ns/op";
+    if (baseline > 0.0) std::cout << "  (" << std::setprecision(2) << baseline / nsPerOp << "x)";
+    std::cout << "\n";
+}
+static void reportThroughput(const char* label, double bytes, double ns) {
+    std::cout << "  " << std::left << std::setw(44) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << bytes / ns * 1e3 << " MB/s\n";
+}
+static std::vector<int> benchThreadCounts() { // 1, 2, 4, ... below the core count, then every core
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+    return counts;
+}
+static ItemRegistry benchRegistry;
+static const ItemDefinition* benchDefinition(int id, ItemKind kind) {
+    if (const ItemDefinition* def = benchRegistry.find(id)) return def;
+
+    auto def = std::make_unique<ItemDefinition>();
+    def->ItemID = id;
+    def->Kind = kind;
+    def->setText("Bench Item " + std::to_string(id), "");
+    def->MaxStack = (kind == ItemKind::Generic) ? 100 : (kind == ItemKind::Potion ? 10 : 1);
+    return benchRegistry.add(std::move(def));
+}
+static std::vector<ItemPtr> makeMixedItems(size_t count) {
+    std::vector<ItemPtr> items;
+    items.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 4) {
+            case 0: items.push_back(ItemFactory::createItem(benchDefinition(1, ItemKind::Weapon))); break;
+            case 1: items.push_back(ItemFactory::createItem(benchDefinition(2, ItemKind::Armor))); break;
+            default: items.push_back(ItemFactory::createItem(benchDefinition(3, ItemKind::Generic))); break; // Potions only at the very end
+        }
+    }
+    items.push_back(ItemFactory::createItem(benchDefinition(4, ItemKind::Potion)));
+    return items;
+}
+
+// Item Kind Benchmarks
+static void benchItemKind() {
+    const size_t sizes[] = { 30, 1000, 100000 };
+
+    for (size_t size : sizes) {
+        auto items = makeMixedItems(size);
+        long long reps = 20000000 / static_cast<long long>(items.size()) + 1;
+        long long ops = reps * static_cast<long long>(items.size());
+
+        std::cout << size << " slots:\n";
+
+        // Per-frame scan, classifying every slot like the inventory hover loop does
+        double rtti = timeNsPerOp(ops, [&] {
+            long long n = 0;
+            for (long long r = 0; r < reps; ++r) {
+                for (auto& it : items) {
+                    if (dynamic_cast<const Potion*>(it.get())) n += 1;
+                    else if (dynamic_cast<const Weapon*>(it.get())) n += 2;
+                    else if (dynamic_cast<const Armor*>(it.get())) n += 3;
+                }
+            }
+            benchSink = benchSink + n;
+        });
+        double tag = timeNsPerOp(ops, [&] {
+            long long n = 0;
+            for (long long r = 0; r < reps; ++r) {
+                for (auto& it : items) {
+                    switch (it->getKind()) {
+                        case ItemKind::Potion: n += 1; break;
+                        case ItemKind::Weapon: n += 2; break;
+                        case ItemKind::Armor: n += 3; break;
+                        default: break;
+                    }
+                }
+            }
+            benchSink = benchSink + n;
+        });
+        report("inventory scan, dynamic_cast", rtti);
+        report("inventory scan, kind tag", tag, rtti);
+
+        // First potion lookup, the potion sits in the last slot
+        double rttiFind = timeNsPerOp(ops, [&] {
+            for (long long r = 0; r < reps; ++r) {
+                for (size_t i = 0; i < items.size(); ++i) {
+                    if (dynamic_cast<const Potion*>(items[i].get())) { benchSink = benchSink + i; break; }
+                }
+            }
+        });
+        double tagFind = timeNsPerOp(ops, [&] {
+            for (long long r = 0; r < reps; ++r) {
+                for (size_t i = 0; i < items.size(); ++i) {
+                    if (items[i]->asPotion()) { benchSink = benchSink + i; break; }
+                }
+            }
+        });
+        report("potion lookup, dynamic_cast", rttiFind);
+        report("potion lookup, kind tag", tagFind, rttiFind);
+    }
+}
+
+// Inventory Stacking Benchmarks
+// The player's bag before BasicInventory: 30 hard-coded std::unique_ptr<Item> slots with the same free bitmap and
+// stack index. Only what the loot rounds call, kept as the reference the template has to keep up with
+class PreTemplateInventory {
+    public:
+        PreTemplateInventory() {
+            FreeSlots.fill(0);
+            for (int i = 0; i < static_cast<int>(GeneralSlots.size()); ++i) FreeSlots[i / 64] |= 1ULL << (i % 64);
+        }
+
+        bool addItem(std::unique_ptr<Item> item) {
+            if (!item) return false;
+
+            int stackIndex = findStackableSlot(*item);
+            while (stackIndex != -1) {
+                unindexSlot(stackIndex);
+                mergeStacks(*GeneralSlots[stackIndex], *item);
+                indexSlot(stackIndex);
+                if (item->getStackCount() == 0) return true;
+                stackIndex = findStackableSlot(*item);
+            }
+
+            for (size_t w = 0; w < FreeSlots.size(); ++w) {
+                if (!FreeSlots[w]) continue;
+# ifdef _MSC_VER
+                unsigned long bit;
+                _BitScanForward64(&bit, FreeSlots[w]);
+                int emptyIndex = static_cast<int>(w * 64 + bit);
+# else
+                int emptyIndex = static_cast<int>(w * 64) + __builtin_ctzll(FreeSlots[w]);
+# endif
+                GeneralSlots[emptyIndex] = std::move(item);
+                indexSlot(emptyIndex);
+                return true;
+            }
+            return false;
+        }
+        bool moveItem(int from, int to) {
+            if (from < 0 || from >= getGeneralSlotCount() || to < 0 || to >= getGeneralSlotCount()) return false;
+            if (!GeneralSlots[from]) return false;
+            if (from == to) return true;
+
+            unindexSlot(from);
+            unindexSlot(to);
+            if (!GeneralSlots[to]) {
+                GeneralSlots[to] = std::move(GeneralSlots[from]);
+            } else if (isStackable(*GeneralSlots[to]) && isStackable(*GeneralSlots[from]) && stackKey(*GeneralSlots[to]) == stackKey(*GeneralSlots[from])) {
+                mergeStacks(*GeneralSlots[to], *GeneralSlots[from]);
+                if (GeneralSlots[from]->getStackCount() == 0) GeneralSlots[from].reset();
+            } else {
+                std::swap(GeneralSlots[from], GeneralSlots[to]);
+            }
+            indexSlot(from);
+            indexSlot(to);
+            return true;
+        }
+        int getGeneralSlotCount() const { return static_cast<int>(GeneralSlots.size()); }
+
+    private:
+        std::array<std::unique_ptr<Item>, 30> GeneralSlots;
+        std::array<unsigned long long, 1> FreeSlots; // Bit set = slot is empty
+        std::unordered_map<unsigned long long, std::vector<int>> OpenStacks;
+
+        static bool isStackable(const Item& item) { return item.getMaxStack() > 1; }
+        static unsigned long long stackKey(const Item& item) {
+            return (static_cast<unsigned long long>(item.getKind()) << 32) | static_cast<unsigned>(item.getItemID());
+        }
+        static void mergeStacks(Item& target, Item& source) {
+            int amount = std::min(target.getMaxStack() - target.getStackCount(), source.getStackCount());
+            target.addToStack(amount);
+            source.removeFromStack(amount);
+        }
+        int findStackableSlot(const Item& item) const {
+            if (!isStackable(item)) return -1;
+            auto it = OpenStacks.find(stackKey(item));
+            return (it == OpenStacks.end() || it->second.empty()) ? -1 : it->second.front();
+        }
+        void unindexSlot(int index) {
+            const Item* item = GeneralSlots[index].get();
+            if (!item || !isStackable(*item)) return;
+            auto it = OpenStacks.find(stackKey(*item));
+            if (it == OpenStacks.end()) return;
+            auto pos = std::find(it->second.begin(), it->second.end(), index);
+            if (pos != it->second.end()) it->second.erase(pos);
+        }
+        void indexSlot(int index) {
+            const Item* item = GeneralSlots[index].get();
+            unsigned long long bit = 1ULL << (index % 64);
+            if (!item) {
+                FreeSlots[index / 64] |= bit;
+                return;
+            }
+            FreeSlots[index / 64] &= ~bit;
+            if (!isStackable(*item) || item->getStackCount() >= item->getMaxStack()) return;
+            auto& slots = OpenStacks[stackKey(*item)];
+            slots.insert(std::lower_bound(slots.begin(), slots.end(), index), index);
+        }
+};
+
+struct LootTimes { // ns per call
+    double add = 0.0;
+    double move = 0.0;
+};
+template <typename Inv, typename MakeInv, typename MakeDrop>
+static LootTimes runLootRounds(const char* label, int slots, MakeInv makeInv, MakeDrop makeDrop, const LootTimes& baseline = {}) {
+    // Loot churn: GenericItem drops of a handful of IDs topping up stacks in a busy inventory
+    const int dropsPerRound = slots * 7;
+    const int rounds = std::max(1, 4000000 / dropsPerRound);
+    std::vector<decltype(makeDrop(nullptr, 1))> drops;
+    drops.reserve(dropsPerRound);
+
+    double addTime = 0.0;
+    double moveTime = 0.0;
+    for (int round = 0; round < rounds; ++round) {
+        Inv inv = makeInv();
+        for (int i = 0; i < dropsPerRound; ++i) {
+            drops.push_back(makeDrop(benchDefinition(100 + i % (slots - 5), ItemKind::Generic), 1 + i % 7));
+        }
+
+        addTime += timeNsPerOp(1, [&] {
+            for (auto& d : drops) inv.addItem(std::move(d));
+        });
+        moveTime += timeNsPerOp(1, [&] {
+            for (int i = 0; i < inv.getGeneralSlotCount(); ++i) inv.moveItem(i, inv.getGeneralSlotCount() - 1 - i);
+        });
+        drops.clear();
+    }
+
+    LootTimes times;
+    times.add = addTime / (static_cast<double>(rounds) * dropsPerRound);
+    times.move = moveTime / (static_cast<double>(rounds) * slots);
+    std::cout << label << ":\n";
+    report("addItem", times.add, baseline.add);
+    report("moveItem", times.move, baseline.move);
+    return times;
+}
+static void benchLoot() {
+    auto pooledDrop = [](const ItemDefinition* def, int count) { return ItemFactory::createItem(def, count); };
+    auto heapDrop = [](const ItemDefinition* def, int count) {
+        std::unique_ptr<Item> item = std::make_unique<GenericItem>(def);
+        item->addToStack(count - 1);
+        return item;
+    };
+
+    // Ratios are against the pre-template bag holding make_unique items as it did then, the fixed size path should not drop below 1x
+    LootTimes before = runLootRounds<PreTemplateInventory>("Pre-template Inventory (std::array, 30)", 30, [] { return PreTemplateInventory(); }, heapDrop);
+    runLootRounds<Inventory>("Inventory (fixed 30)", 30, [] { return Inventory(); }, pooledDrop, before);
+    runLootRounds<DynamicInventory>("DynamicInventory (30)", 30, [] { return DynamicInventory(30); }, pooledDrop, before);
+    runLootRounds<DynamicInventory>("DynamicInventory (5000)", 5000, [] { return DynamicInventory(5000); }, pooledDrop);
+}
+
+// Item Pool Benchmarks
+static void benchItemPool() {
+    // Loot/consume churn: keep a few hundred live items and keep replacing them
+    const int live = 512;
+    const long long churn = 4000000;
+    const ItemDefinition* def = benchDefinition(500, ItemKind::Generic);
+
+    std::vector<std::unique_ptr<Item>> heapItems(live);
+    double heap = timeNsPerOp(churn, [&] {
+        for (long long i = 0; i < churn; ++i) heapItems[i % live] = std::make_unique<GenericItem>(def);
+    });
+    heapItems.clear();
+
+    reserveItemPool(ItemKind::Generic, live + 1); // +1 for the replacement made before the old item dies
+    ItemPoolStats before = getItemPoolStats(ItemKind::Generic);
+
+    std::vector<ItemPtr> pooledItems(live);
+    double pooled = timeNsPerOp(churn, [&] {
+        for (long long i = 0; i < churn; ++i) pooledItems[i % live] = ItemFactory::createItem(def);
+    });
+    pooledItems.clear();
+
+    ItemPoolStats after = getItemPoolStats(ItemKind::Generic);
+    report("create + destroy, make_unique", heap);
+    report("create + destroy, item pool", pooled, heap);
+    std::cout << "  pool: " << after.allocations - before.allocations << " allocations, "
+              << after.releases - before.releases << " releases, " << after.slabs - before.slabs
+              << " new slabs during churn, " << after.live << " live\n";
+}
+
+// Content Loading Benchmarks
+static std::string writeSyntheticContent(int itemCount, int npcCount, std::string& npcPath) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string itemPath = (dir / "bench_items.txt").string();
+    npcPath = (dir / "bench_npcs.txt").string();
+
+    std::ofstream items(itemPath);
+    for (int i = 1; i <= itemCount; ++i) {
+        items << i << " - Synthetic Item " << i << "\n";
+        items << "\tDescription: Generated for the loading benchmark, entry number " << i << "\n";
+        switch (i % 4) {
+            case 0: items << "\tDamage: " << 10 + i % 50 << "\n\tEquippable\n"; break;
+            case 1: items << "\tDefense: " << 1 + i % 9 << "\n\tHealth: " << i % 7 << "\n\tBoots\n\tEquippable\n"; break;
+            case 2: items << "\tHealing: " << 5 + i % 40 << "\n\tConsumable\n"; break;
+            default: break;
+        }
+        items << "-----------\n";
+    }
+
+    std::ofstream npcs(npcPath);
+    for (int i = 1; i <= npcCount; ++i) {
+        npcs << i << " - Synthetic NPC " << i << "\n\tType: " << (i % 5 ? "Enemy" : "Friendly") << "\n";
+        npcs << "\tHealth: " << 50 + i % 100 << "\n\tDamage: " << i % 20 << "\n\tDefense: " << i % 3
+             << "\n\tXP: " << i % 10 << "\n\tGold: " << i % 30 << "\n----------\n";
+    }
+
+    return itemPath;
+}
+static void benchContentLoad() {
+    const int itemCount = 200000;
+    const int npcCount = 50000;
+
+    std::string npcPath;
+    std::string itemPath = writeSyntheticContent(itemCount, npcCount, npcPath);
+    std::string binPath = (std::filesystem::temp_directory_path() / "bench_gamedata.bin").string();
+
+    {
+        ItemFactory itemfactory;
+        NPCFactory npcfactory;
+        itemfactory.loadItems(itemPath);
+        auto npcs = npcfactory.loadNPCs(npcPath);
+
+        std::vector<const NPC*> npcList;
+        for (auto& pair : npcs) npcList.push_back(pair.second.get());
+        writeGameData(binPath, itemfactory.getRegistry().getDefinitions(), npcList);
+    }
+
+    std::cout << itemCount << " items, " << npcCount << " NPCs, " << std::filesystem::file_size(binPath) / 1024 << " KiB compiled:\n";
+
+    const int reps = 3;
+    double text = timeNsPerOp(reps, [&] {
+        for (int r = 0; r < reps; ++r) {
+            ItemFactory itemfactory;
+            NPCFactory npcfactory;
+            auto items = itemfactory.loadItems(itemPath);
+            auto npcs = npcfactory.loadNPCs(npcPath);
+            benchSink = benchSink + static_cast<long long>(items.size() + npcs.size());
+        }
+    });
+    double compiled = timeNsPerOp(reps, [&] {
+        for (int r = 0; r < reps; ++r) {
+            ItemFactory itemfactory;
+            NPCFactory npcfactory;
+            GameDataFile data;
+            data.open(binPath);
+            auto items = itemfactory.loadItems(data);
+            auto npcs = npcfactory.loadNPCs(data);
+            benchSink = benchSink + static_cast<long long>(items.size() + npcs.size());
+        }
+    });
+
+    std::cout << "  " << std::left << std::setw(44) << "text parse (ms)" << std::right << std::setw(10) << text / 1e6 << "\n";
+    std::cout << "  " << std::left << std::setw(44) << "compiled mmap (ms)" << std::right << std::setw(10) << compiled / 1e6
+              << "  (" << text / compiled << "x)\n";
+
+    std::filesystem::remove(itemPath);
+    std::filesystem::remove(npcPath);
+    std::filesystem::remove(binPath);
+}
+
+static void benchTextParse() {
+    const int itemCount = 1000000;
+    const int npcCount = 250000;
+
+    std::string npcPath;
+    std::string itemPath = writeSyntheticContent(itemCount, npcCount, npcPath);
+    double itemBytes = static_cast<double>(std::filesystem::file_size(itemPath));
+    double npcBytes = static_cast<double>(std::filesystem::file_size(npcPath));
+
+    std::cout << itemCount << " items (" << static_cast<int>(itemBytes / 1e6) << " MB), "
+              << npcCount << " NPCs (" << static_cast<int>(npcBytes / 1e6) << " MB):\n";
+
+    std::string buffer;
+    readTextFile(itemPath, buffer);
+    double scan = timeNsPerOp(1, [&] {
+        TextScanner scanner(buffer);
+        std::vector<TextLine> block;
+        long long lines = 0;
+        while (scanner.nextBlock("-----------", block)) lines += static_cast<long long>(block.size());
+        benchSink = benchSink + lines;
+    });
+    double items = timeNsPerOp(1, [&] {
+        ItemFactory itemfactory;
+        benchSink = benchSink + static_cast<long long>(itemfactory.loadItems(itemPath).size());
+    });
+    double npcs = timeNsPerOp(1, [&] {
+        NPCFactory npcfactory;
+        benchSink = benchSink + static_cast<long long>(npcfactory.loadNPCs(npcPath).size());
+    });
+
+    reportThroughput("tokenizer only (items)", itemBytes, scan);
+    reportThroughput("loadItems (parse + definitions + instances)", itemBytes, items);
+    reportThroughput("loadNPCs", npcBytes, npcs);
+
+    // An empty value keeps its place in the line, the diagnostic points past the trailing spaces
+    TextLine emptyValue{ "\tDamage:  ", 2 };
+    std::vector<ParseDiagnostic> diagnostics;
+    int unused = 0;
+    parseInt(emptyValue, emptyValue.text.substr(8), unused, diagnostics);
+    int column = diagnostics.empty() ? 0 : diagnostics[0].column;
+    std::cout << "  " << std::left << std::setw(44) << "empty value diagnostic column" << std::right << std::setw(10) << column
+              << (column == 11 ? "  ok\n" : "  WRONG, expected 11\n");
+
+    std::filesystem::remove(itemPath);
+    std::filesystem::remove(npcPath);
+}
+
+static void benchContentPack() {
+    // 256 region item files plus 64 NPC files, IDs overlap between neighbours so the merge does real overriding
+    const int itemFiles = 256;
+    const int npcFiles = 64;
+    const int perFile = 2000;
+    auto dir = std::filesystem::temp_directory_path() / "bench_pack";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "regions");
+    std::filesystem::create_directories(dir / "npcs");
+
+    for (int f = 0; f < itemFiles; ++f) {
+        std::ofstream items(dir / "regions" / ("region_" + std::to_string(1000 + f) + ".items.txt"));
+        for (int i = 0; i < perFile; ++i) {
+            int id = f * (perFile - 100) + i + 1;
+            items << id << " - Region " << f << " Item " << i << "\n\tDescription: Loot from region " << f << "\n";
+            if (i % 3 == 0) items << "\tDamage: " << 5 + i % 40 << "\n\tEquippable\n";
+            else if (i % 3 == 1) items << "\tHealing: " << 5 + i % 20 << "\n\tConsumable\n";
+            items << "-----------\n";
+        }
+    }
+    for (int f = 0; f < npcFiles; ++f) {
+        std::ofstream npcs(dir / "npcs" / ("region_" + std::to_string(1000 + f) + ".npcs.txt"));
+        for (int i = 0; i < perFile; ++i) {
+            npcs << f * perFile + i + 1 << " - Region " << f << " NPC " << i << "\n\tType: Enemy\n\tHealth: " << 20 + i % 80
+                 << "\n\tDamage: " << i % 9 << "\n\tGold: " << i % 13 << "\n----------\n";
+        }
+    }
+
+    std::cout << itemFiles << " item files + " << npcFiles << " NPC files, " << perFile << " blocks each:\n";
+
+    double single = 0.0;
+    for (int threads : benchThreadCounts()) {
+        JobSystem jobs(threads);
+        double ns = timeNsPerOp(1, [&] {
+            ItemFactory itemfactory;
+            ContentPack pack = loadContentPack(dir.string(), itemfactory, {}, jobs);
+            benchSink = benchSink + static_cast<long long>(pack.overrides.size() + pack.npcs.size());
+        });
+        if (threads == 1) single = ns;
+
+        std::string label = "loadContentPack, " + std::to_string(threads) + " thread" + (threads > 1 ? "s (ms)" : " (ms)");
+        std::cout << "  " << std::left << std::setw(44) << label << std::right << std::setw(10) << ns / 1e6
+                  << "  (" << single / ns << "x)\n";
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+// Atlas Packing Benchmarks
+static void benchAtlasPack() {
+    // Sprite sheets for a bigger content set: a few thousand icons and portraits of mixed sizes, tallest first
+    const int spriteCount = 4000;
+    const int pageSize = 2048;
+    std::vector<std::pair<int, int>> sizes;
+    uint64_t rng = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < spriteCount; ++i) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        int side = (i % 10 == 0) ? 96 + static_cast<int>(rng % 160) : 16 + static_cast<int>(rng % 64);
+        sizes.push_back({ side + 2, side + 2 - static_cast<int>(rng % 8) });
+    }
+    std::sort(sizes.begin(), sizes.end(), [](auto a, auto b) { return a.second > b.second; });
+
+    std::vector<RectPacker> pages;
+    double ns = timeNsPerOp(spriteCount, [&] {
+        for (auto [w, h] : sizes) {
+            int x, y;
+            bool placed = false;
+            for (auto& page : pages) {
+                if ((placed = page.insert(w, h, x, y))) break;
+            }
+            if (!placed) {
+                pages.emplace_back(pageSize, pageSize);
+                pages.back().insert(w, h, x, y);
+            }
+        }
+    });
+
+    double occupancy = 0.0;
+    for (auto& page : pages) occupancy += page.getOccupancy();
+
+    std::cout << spriteCount << " sprites onto " << pageSize << "x" << pageSize << " pages:\n";
+    report("skyline insert", ns);
+    std::cout << "  " << pages.size() << " pages, " << std::setprecision(1) << 100.0 * occupancy / pages.size() << "% average occupancy\n";
+}
+
+// Broadphase Benchmarks
+static void benchBroadphase() {
+    // Same density at every size, one 32x32 NPC per 96x96 of map, so the map grows with the count.
+    // Every tick each NPC takes a step and checks what it now overlaps, like the player does
+    const int counts[] = { 10000, 25000, 50000, 100000 };
+    const int ticks = 20;
+    const int playerQueries = 2000;
+
+    for (int count : counts) {
+        int side = static_cast<int>(std::sqrt(static_cast<double>(count)) * 96);
+        uint64_t rng = 0x9E3779B97F4A7C15ULL;
+        auto next = [&](int range) {
+            rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+            return static_cast<int>(rng % static_cast<uint64_t>(range));
+        };
+
+        WorldEntities world;
+        world.reserve(count);
+        std::vector<int> stepX(count), stepY(count);
+        for (int i = 0; i < count; ++i) {
+            world.add(1 + i % 4, next(side), next(side));
+            stepX[i] = next(5) - 2;
+            stepY[i] = next(5) - 2;
+        }
+
+        std::vector<int> found;
+        long long contacts = 0;
+        double tickNs = timeNsPerOp(static_cast<long long>(count) * ticks, [&] {
+            for (int t = 0; t < ticks; ++t) {
+                for (int i = 0; i < count; ++i) {
+                    int x = world.getX(i) + stepX[i];
+                    int y = world.getY(i) + stepY[i];
+                    if (x < 0 || x > side) stepX[i] = -stepX[i];
+                    if (y < 0 || y > side) stepY[i] = -stepY[i];
+                    world.move(i, x, y);
+                }
+                for (int i = 0; i < count; ++i) {
+                    world.queryBox(world.getX(i), world.getY(i), world.getW(i), world.getH(i), found);
+                    contacts += static_cast<long long>(found.size());
+                }
+            }
+        });
+
+        // One player sized box against the whole map: through the grid, then every NPC one by one and four at a time
+        std::vector<int> xs(count), ys(count), ws(count), hs(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = world.getX(i);
+            ys[i] = world.getY(i);
+            ws[i] = world.getW(i);
+            hs[i] = world.getH(i);
+        }
+        std::vector<std::pair<int, int>> probes;
+        for (int q = 0; q < playerQueries; ++q) probes.push_back({ next(side), next(side) });
+
+        long long hitCount = 0;
+        double gridNs = timeNsPerOp(playerQueries, [&] {
+            for (auto [px, py] : probes) hitCount += world.findOverlap(px, py, 32, 32) >= 0;
+        });
+        double scalarNs = timeNsPerOp(playerQueries, [&] {
+            for (auto [px, py] : probes) {
+                for (int i = 0; i < count; ++i) {
+                    if (xs[i] < px + 32 && px < xs[i] + ws[i] && ys[i] < py + 32 && py < ys[i] + hs[i]) {
+                        hitCount++;
+                        break;
+                    }
+                }
+            }
+        });
+        std::vector<int> hits;
+        double batchNs = timeNsPerOp(playerQueries, [&] {
+            for (auto [px, py] : probes) {
+                hits.clear();
+                overlapBoxes(xs.data(), ys.data(), ws.data(), hs.data(), count, px, py, 32, 32, hits);
+                hitCount += !hits.empty();
+            }
+        });
+        benchSink = benchSink + contacts + hitCount;
+
+        std::cout << count << " moving NPCs on a " << side << "x" << side << " map, " << world.getGrid().getCellCount() << " cells:\n";
+        report("tick, move + overlap query, per NPC", tickNs);
+        std::cout << "  " << std::left << std::setw(44) << "tick, whole map" << std::right << std::setw(10)
+                  << tickNs * count / 1e6 << " ms\n";
+        report("player overlap, linear scan", scalarNs);
+        report("player overlap, linear overlapBoxes", batchNs, scalarNs);
+        report("player overlap, grid", gridNs, scalarNs);
+    }
+}
+
+// Job System Benchmarks
+static void benchJobs() {
+    // Empty jobs measure what a job itself costs. The hash loop stands in for real per-element work like ticking NPCs
+    static const int EmptyJobs = 200000;
+    static const int Roots = 256;
+    static const int Children = 256;
+    const int elements = 1 << 22;
+    std::vector<uint32_t> values(elements);
+
+    double singleFor = 0.0;
+    for (int threads : benchThreadCounts()) {
+        JobSystem jobs(threads);
+        std::cout << threads << (threads > 1 ? " threads:\n" : " thread:\n");
+
+        double emptyNs = timeNsPerOp(EmptyJobs, [&] {
+            JobCounter counter;
+            for (int i = 0; i < EmptyJobs; ++i) jobs.run(counter, [] {});
+            jobs.wait(counter);
+        });
+
+        // Jobs that submit jobs, everything lands on whichever deque the root ran on so the rest has to be stolen
+        double fanNs = timeNsPerOp(static_cast<long long>(Roots) * Children, [&] {
+            JobCounter counter;
+            JobSystem* system = &jobs;
+            JobCounter* group = &counter;
+            for (int r = 0; r < Roots; ++r) {
+                jobs.run(counter, [system, group] {
+                    for (int c = 0; c < Children; ++c) system->run(*group, [] {});
+                });
+            }
+            jobs.wait(counter);
+        });
+
+        jobs.resetStats();
+        double forNs = timeNsPerOp(elements, [&] {
+            jobs.parallelFor(0, elements, 0, [&](int first, int last) {
+                for (int i = first; i < last; ++i) {
+                    uint32_t h = static_cast<uint32_t>(i);
+                    for (int r = 0; r < 32; ++r) h = (h * 2654435761u) ^ (h >> 15);
+                    values[i] = h;
+                }
+            });
+        });
+        std::vector<WorkerStats> stats = jobs.getStats();
+        if (threads == 1) singleFor = forNs;
+        benchSink = benchSink + values[elements / 3];
+
+        report("empty job, submit + run", emptyNs);
+        report("empty job, spawned from jobs", fanNs);
+        report("parallelFor 32-round hash, per element", forNs, singleFor);
+        if (threads > 1) { // One thread runs parallelFor inline, there are no jobs to count
+            std::cout << "  parallelFor busy per thread:";
+            long long steals = 0;
+            for (const WorkerStats& w : stats) {
+                std::cout << " " << std::setprecision(0) << 100.0 * w.utilisation << "%";
+                steals += w.steals;
+            }
+            std::cout << ", " << steals << " steals\n" << std::setprecision(2);
+        }
+    }
+}
+
+// Main Function for execution
+int main(int argc, char** argv) {
+    std::vector<Benchmark> benchmarks = {
+        { "itemkind", benchItemKind },
+        { "loot", benchLoot },
+        { "itempool", benchItemPool },
+        { "contentload", benchContentLoad },
+        { "textparse", benchTextParse },
+        { "contentpack", benchContentPack },
+        { "atlaspack", benchAtlasPack },
+        { "broadphase", benchBroadphase },
+        { "jobs", benchJobs },
+    };
+
+    for (auto& b : benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            if (b.name == std::string(argv[i])) selected = true;
+        }
+        if (!selected) continue;
+
+        std::cout << "=== " << b.name << " ===\n";
+        b.run();
+    }
+
+    return 0;
+}
+
+// Build with:
+// g++ -O2 RPG_Benchmarks.cpp RPG_Inventory_System.cpp NPCs.cpp GameData.cpp TextParser.cpp ContentPack.cpp RectPacker.cpp WorldEntities.cpp SpatialHash.cpp JobSystem.cpp -pthread -o bench
@@ -1,92 +1,325 @@
 // Includes
 # include "RPG_Inventory_System.hpp"
+# include "GameData.hpp"
 # include <iostream>
 # include <fstream>
 # include <vector>
 # include <array>
+# include <algorithm>
+# include <cstring>
+# include <new>
 
 // Function Declarations
+static inline int lowestSetBit(unsigned long long bits) {
+# ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+# else
+    return __builtin_ctzll(bits);
+# endif
+}
+
+
+// Item Pools
+template < typename T >
+class ItemPool {
+    public:
+    template < typename...Args >
+    T* create(Args&&...args) {
+        if (!FreeList)
+        grow();
+
+        FreeNode* node = FreeList;
+        FreeList = node->next;
+
+        Stats.allocations++;
+        Stats.live++;
+        return new (node) T(std::forward < Args > (args)...);
+    }
+    void destroy(T* item) {
+        item->~T();
+
+        FreeNode* node = reinterpret_cast < FreeNode* > (item);
+        node->next = FreeList;
+        FreeList = node;
+
+        Stats.releases++;
+        Stats.live--;
+    }
+    void reserve(int count) {
+        while (Stats.capacity - Stats.live < count)
+        grow();
+    }
+    const ItemPoolStats& getStats() const { return Stats; }
+
+    private:
+    static constexpr int SlabItems = 256;
+
+    union FreeNode {
+        FreeNode* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector < std::unique_ptr < FreeNode[] >> Slabs;
+    FreeNode* FreeList = nullptr;
+    ItemPoolStats Stats;
+
+    void grow() {
+        Slabs.push_back(std::make_unique < FreeNode[] > (SlabItems));
+        FreeNode* slab = Slabs.back().get();
+
+        // Thread the new slab onto the free list back to front so allocation walks it in address order
+        for (int i = SlabItems - 1; i >= 0; --i) {
+            slab[i].next = FreeList;
+            FreeList = &slab[i];
+        }
+
+        Stats.slabs++;
+        Stats.capacity += SlabItems;
+    }
+};
+
+template < typename T >
+static ItemPool < T >& itemPool() {
+    static ItemPool < T >* pool = new ItemPool < T > (); // Never freed, items can still die during static destruction
+    return *pool;
+}
+
+void ItemDeleter::operator()(Item* item) const {
+    switch (item->getKind()) {
+        case ItemKind::Weapon: itemPool < Weapon > ().destroy(static_cast < Weapon* > (item)); break;
+        case ItemKind::Armor: itemPool < Armor > ().destroy(static_cast < Armor* > (item)); break;
+        case ItemKind::Potion: itemPool < Potion > ().destroy(static_cast < Potion* > (item)); break;
+        default: itemPool < GenericItem > ().destroy(static_cast < GenericItem* > (item)); break;
+    }
+}
+ItemPoolStats getItemPoolStats(ItemKind kind) {
+    switch (kind) {
+        case ItemKind::Weapon: return itemPool < Weapon > ().getStats();
+        case ItemKind::Armor: return itemPool < Armor > ().getStats();
+        case ItemKind::Potion: return itemPool < Potion > ().getStats();
+        default: return itemPool < GenericItem > ().getStats();
+    }
+}
+void reserveItemPool(ItemKind kind, int count) {
+    switch (kind) {
+        case ItemKind::Weapon: itemPool < Weapon > ().reserve(count); break;
+        case ItemKind::Armor: itemPool < Armor > ().reserve(count); break;
+        case ItemKind::Potion: itemPool < Potion > ().reserve(count); break;
+        default: itemPool < GenericItem > ().reserve(count); break;
+    }
+}
+
+// ItemDefinition Functions
+void ItemDefinition::setText(std::string_view name, std::string_view description) {
+    Text = std::make_unique < char[] > (name.size() + description.size());
+    std::memcpy(Text.get(), name.data(), name.size());
+    std::memcpy(Text.get() + name.size(), description.data(), description.size());
+    Name = std::string_view(Text.get(), name.size());
+    Description = std::string_view(Text.get() + name.size(), description.size());
+}
+
+// ItemRegistry Functions
+const ItemDefinition* ItemRegistry::add(std::unique_ptr < ItemDefinition > def) {
+    if (!def)
+    return nullptr;
+
+    ItemDefinition* slot = emplace(def->ItemID);
+    *slot = std::move(*def); // Text moves as a pointer, so Name and Description stay valid
+    return slot;
+}
+ItemDefinition* ItemRegistry::emplace(int id) {
+    if ((Count + 1) * 2 > static_cast<int > (Table.size()))
+    growTable(Count + 1);
 
+    Slot& slot = Table[findSlot(id)];
+    if (slot.def)
+    return slot.def;
+
+    if (BlockUsed == BlockCapacity) {
+        BlockCapacity = std::max(256, Count); // Doubles the total each time
+        Blocks.push_back(std::make_unique < ItemDefinition[] > (BlockCapacity));
+        BlockUsed = 0;
+    }
+    slot.id = id;
+    slot.def = &Blocks.back()[BlockUsed++];
+    slot.def->ItemID = id;
+    ++Count;
+    return slot.def;
+}
+size_t ItemRegistry::findSlot(int id) const {
+    size_t mask = Table.size() - 1;
+    size_t i = static_cast<size_t > ((static_cast<unsigned long long > (static_cast<unsigned > (id)) * 0x9E3779B97F4A7C15ull) >> TableShift);
+    while (Table[i].def && Table[i].id != id)
+    i = (i + 1) & mask;
+    return i;
+}
+void ItemRegistry::growTable(int count) {
+    size_t size = 16;
+    int shift = 60;
+    while (size < static_cast<size_t > (count) * 2) {
+        size *= 2;
+        --shift;
+    }
+    if (size <= Table.size())
+    return;
+
+    std::vector < Slot > old = std::move(Table);
+    Table.assign(size, Slot {});
+    TableShift = shift;
+    for (const Slot& slot : old) {
+        if (slot.def)
+        Table[findSlot(slot.id)] = slot;
+    }
+}
+const ItemDefinition* ItemRegistry::find(int id) const {
+    return Table.empty() ? nullptr : Table[findSlot(id)].def;
+}
+int ItemRegistry::size() const {
+    return Count;
+}
+void ItemRegistry::reserve(int count) {
+    growTable(Count + count);
+    if (BlockCapacity - BlockUsed < count) { // One block for the whole batch, what was left of the last one stays unused
+        Blocks.push_back(std::make_unique < ItemDefinition[] > (count));
+        BlockCapacity = count;
+        BlockUsed = 0;
+    }
+}
+void ItemRegistry::keepAlive(std::shared_ptr < const void > storage) {
+    if (storage)
+    Storage.push_back(std::move(storage));
+}
+std::vector < const ItemDefinition* > ItemRegistry::getDefinitions() const {
+    std::vector < const ItemDefinition* > defs;
+    defs.reserve(Count);
+    for (const Slot& slot : Table) {
+        if (slot.def)
+        defs.push_back(slot.def);
+    }
+
+    std::sort(defs.begin(), defs.end(), [](const ItemDefinition* a, const ItemDefinition* b) {
+        return a->ItemID < b->ItemID;
+    });
+    return defs;
+}
 
 // Item Functions
-const std::string& Item::getName() const {
-    return Name;
+Item::Item(const ItemDefinition* def) : Def(def), Kind(def->Kind) {}
+std::string_view Item::getName() const {
+    return Def->Name;
 }
-const std::string& Item::getDescription() const {
-    return Description;
+std::string_view Item::getDescription() const {
+    return Def->Description;
 }
-const std::vector < Trait>& Item::getTraits() const {
-    return Traits;
+TraitSet Item::getTraits() const {
+    return Def->Traits;
 }
 int Item::getStackCount() const {
     return StackCount;
 }
 int Item::getMaxStack() const {
-    return MaxStack;
+    return Def->MaxStack;
 }
-int Item::getItemID() const { return ItemID; }
-void Item::setName(const std::string& n) { Name = n; } 
-void Item::setDescription(const std::string& d) { Description = d; } 
-void Item::setTraits(const std::vector<Trait>& t) { Traits = t; } 
+int Item::getItemID() const { return Def->ItemID; }
 void Item::addToStack(int amount) { StackCount += amount; } 
 void Item::removeFromStack(int amount) { StackCount -= amount; } 
-void Item::setItemID(int id) { ItemID = id; }
 
 // Inventory Functions
-Inventory::Inventory() {}
-bool Inventory::addItem(std::unique_ptr < Item > item) {
+template <int GeneralN, int ArmorN>
+BasicInventory<GeneralN, ArmorN>::BasicInventory(int GeneralSlotCount) {
+    if constexpr (GeneralN == DynamicSlots) {
+        GeneralSlots.resize(std::max(0, GeneralSlotCount));
+        FreeSlots.resize((GeneralSlots.size() + 63) / 64);
+    }
+
+    std::fill(FreeSlots.begin(), FreeSlots.end(), 0);
+    for (int i = 0; i < static_cast<int>(GeneralSlots.size()); ++i)
+    FreeSlots[i / 64] |= 1ULL << (i % 64);
+}
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::addItem(ItemPtr item) {
     if (!item)
     return false;
 
-    // Try Stacking first
+    // Try Stacking first, topping up partial stacks until the item runs out
     int stackIndex = findStackableSlot(*item);
-    if (stackIndex != -1) {
+    while (stackIndex != -1) {
+        unindexSlot(stackIndex);
         mergeStacks(*GeneralSlots[stackIndex], *item);
+        indexSlot(stackIndex);
+
         if (item->getStackCount() == 0)
         return true;
+
+        stackIndex = findStackableSlot(*item);
     }
 
     // Try Empty slots
     int emptyIndex = findFirstEmptyGeneralSlot();
     if (emptyIndex != -1) {
         GeneralSlots[emptyIndex] = std::move(item);
+        indexSlot(emptyIndex);
         return true;
     }
 
     // Since Everything has been tested, inventory must be full
     return false;
 }
-std::unique_ptr < Item > Inventory::removeItem(int SlotIndex) {
+template <int GeneralN, int ArmorN>
+ItemPtr BasicInventory<GeneralN, ArmorN>::removeItem(int SlotIndex) {
     if (!isValidGeneralSlot(SlotIndex))
     return nullptr;
 
-    return std::move(GeneralSlots[SlotIndex]);
+    unindexSlot(SlotIndex);
+    auto item = std::move(GeneralSlots[SlotIndex]);
+    indexSlot(SlotIndex);
+    return item;
 }
-bool Inventory::moveItem(int from, int to) {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::removeFromStack(int SlotIndex, int amount) {
+    if (!isValidGeneralSlot(SlotIndex) || !GeneralSlots[SlotIndex])
+    return false;
+
+    unindexSlot(SlotIndex);
+    GeneralSlots[SlotIndex]->removeFromStack(amount);
+    if (GeneralSlots[SlotIndex]->getStackCount() <= 0)
+    GeneralSlots[SlotIndex].reset();
+    indexSlot(SlotIndex);
+    return true;
+}
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::moveItem(int from, int to) {
     if (!isValidGeneralSlot(from) || !isValidGeneralSlot(to))
     return false;
 
     if (!GeneralSlots[from])
     return false;
 
+    if (from == to)
+    return true;
+
+    unindexSlot(from);
+    unindexSlot(to);
+
     if (!GeneralSlots[to]) {
         GeneralSlots[to] = std::move(GeneralSlots[from]);
-        return true;
-    }
-
-    if (canStack(*GeneralSlots[to], *GeneralSlots[from])) {
+    } else if (canStack(*GeneralSlots[to], *GeneralSlots[from])) {
         mergeStacks(*GeneralSlots[to], *GeneralSlots[from]);
 
         if (GeneralSlots[from]->getStackCount() == 0)
         GeneralSlots[from].reset();
-
-        return true;
+    } else {
+        std::swap(GeneralSlots[from], GeneralSlots[to]);
     }
 
-    std::swap(GeneralSlots[from], GeneralSlots[to]);
+    indexSlot(from);
+    indexSlot(to);
     return true;
 }
-bool Inventory::equipItem(int SlotIndex) {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::equipItem(int SlotIndex) {
     if (!isValidGeneralSlot(SlotIndex))
     return false;
 
@@ -95,146 +328,251 @@ bool Inventory::equipItem(int SlotIndex) {
 
     Item& item = *GeneralSlots[SlotIndex];
 
-    if (isWeapon(item)) {
-        auto old = std::move(WeaponSlot);
-        WeaponSlot = std::move(GeneralSlots[SlotIndex]);
-        GeneralSlots[SlotIndex] = std::move(old);
-        return true;
-    }
-
-    if (isArmor(item)) {
-        Armor& armor = static_cast<Armor&>(item);
-        ArmorSlotType type = armor.getSlot();
-        int index = static_cast<int>(type);
-		
-        if (ArmorSlots[index]) {
-			Armor& equipped = static_cast<Armor&>(*ArmorSlots[index]);
-			if (equipped.getSlot() == type) {
-				auto old = std::move(ArmorSlots[index]);
-				ArmorSlots[index] = std::move(GeneralSlots[SlotIndex]);
-				GeneralSlots[SlotIndex] = std::move(old);
-				return true;
-			}
-		} else {
-			ArmorSlots[index] = std::move(GeneralSlots[SlotIndex]);
-			return true;
-		}
+    // Equipables never stack, so only the free bit of this slot can change
+    switch (item.getKind()) {
+        case ItemKind::Weapon: {
+            applyEquipmentStats(WeaponSlot.get(), -1);
+            applyEquipmentStats(&item, 1);
+
+            auto old = std::move(WeaponSlot);
+            WeaponSlot = std::move(GeneralSlots[SlotIndex]);
+            GeneralSlots[SlotIndex] = std::move(old);
+            indexSlot(SlotIndex);
+            return true;
+        }
+        case ItemKind::Armor: {
+            Armor& armor = static_cast<Armor&>(item);
+            ArmorSlotType type = armor.getSlot();
+            int index = static_cast<int>(type);
+            if (!isValidArmorSlot(type))
+            return false;
+
+            if (ArmorSlots[index]) {
+                Armor& equipped = static_cast<Armor&>(*ArmorSlots[index]);
+                if (equipped.getSlot() == type) {
+                    applyEquipmentStats(&equipped, -1);
+                    applyEquipmentStats(&armor, 1);
+
+                    auto old = std::move(ArmorSlots[index]);
+                    ArmorSlots[index] = std::move(GeneralSlots[SlotIndex]);
+                    GeneralSlots[SlotIndex] = std::move(old);
+                    indexSlot(SlotIndex);
+                    return true;
+                }
+            } else {
+                applyEquipmentStats(&armor, 1);
+                ArmorSlots[index] = std::move(GeneralSlots[SlotIndex]);
+                indexSlot(SlotIndex);
+                return true;
+            }
+            break;
+        }
+        default:
+            break;
     }
 
     return false; // All else failed
 }
-std::unique_ptr < Item > Inventory::unequipWeapon() {
+template <int GeneralN, int ArmorN>
+ItemPtr BasicInventory<GeneralN, ArmorN>::unequipWeapon() {
+    applyEquipmentStats(WeaponSlot.get(), -1);
     return std::move(WeaponSlot);
 }
-std::unique_ptr < Item > Inventory::unequipArmor(ArmorSlotType type) {
+template <int GeneralN, int ArmorN>
+ItemPtr BasicInventory<GeneralN, ArmorN>::unequipArmor(ArmorSlotType type) {
     int index = static_cast<int > (type);
     if (!isValidArmorSlot(type))
     return nullptr;
 
+    applyEquipmentStats(ArmorSlots[index].get(), -1);
     return std::move(ArmorSlots[index]);
 }
-Item* Inventory::getItem(int SlotIndex) {
+template <int GeneralN, int ArmorN>
+Item* BasicInventory<GeneralN, ArmorN>::getItem(int SlotIndex) {
     if (!isValidGeneralSlot(SlotIndex)) return nullptr;
     return GeneralSlots[SlotIndex].get();
 }
-const Item* Inventory::getItem(int SlotIndex) const {
+template <int GeneralN, int ArmorN>
+const Item* BasicInventory<GeneralN, ArmorN>::getItem(int SlotIndex) const {
     if (!isValidGeneralSlot(SlotIndex)) return nullptr;
     return GeneralSlots[SlotIndex].get();
 }
-bool Inventory::isSlotEmpty(int SlotIndex) const {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isSlotEmpty(int SlotIndex) const {
     if (!isValidGeneralSlot(SlotIndex))
     return true;
 
     return !GeneralSlots[SlotIndex];
 }
-const Item* Inventory::getEquippedWeapon() const {
+template <int GeneralN, int ArmorN>
+const Item* BasicInventory<GeneralN, ArmorN>::getEquippedWeapon() const {
     return WeaponSlot.get();
 }
-const Item* Inventory::getEquippedArmor(ArmorSlotType type) const {
+template <int GeneralN, int ArmorN>
+const Item* BasicInventory<GeneralN, ArmorN>::getEquippedArmor(ArmorSlotType type) const {
     int index = static_cast<int > (type);
     if (!isValidArmorSlot(type))
     return nullptr;
 
     return ArmorSlots[index].get();
 }
-int Inventory::getGeneralSlotCount() const {
+template <int GeneralN, int ArmorN>
+int BasicInventory<GeneralN, ArmorN>::getGeneralSlotCount() const {
     return static_cast<int > (GeneralSlots.size());
 }
-int Inventory::getArmorSlotCount() const {
+template <int GeneralN, int ArmorN>
+int BasicInventory<GeneralN, ArmorN>::getArmorSlotCount() const {
     return static_cast<int > (ArmorSlots.size());
 }
-bool Inventory::isValidGeneralSlot(int Index) const {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isValidGeneralSlot(int Index) const {
     return Index >= 0 && Index < static_cast<int > (GeneralSlots.size());
 }
-bool Inventory::isValidArmorSlot(ArmorSlotType type) const {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isValidArmorSlot(ArmorSlotType type) const {
     int index = static_cast<int > (type);
     return index >= 0 && index < static_cast<int > (ArmorSlots.size());
 }
-bool Inventory::isWeapon(const Item& item) const {
-    return dynamic_cast<const Weapon*>(&item) != nullptr;
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isWeapon(const Item& item) const {
+    return item.getKind() == ItemKind::Weapon;
 }
-bool Inventory::isArmor(const Item& item) const {
-    return dynamic_cast<const Armor*>(&item) != nullptr;
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isArmor(const Item& item) const {
+    return item.getKind() == ItemKind::Armor;
 }
-bool Inventory::isPotion(const Item& item) const {
-    return dynamic_cast<const Potion*>(&item) != nullptr;
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isPotion(const Item& item) const {
+    return item.getKind() == ItemKind::Potion;
 }
-bool Inventory::isStackable(const Item& item) const {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::isStackable(const Item& item) const {
     return item.getMaxStack() > 1;
 }
-bool Inventory::canStack(const Item& a, const Item& b) const {
+template <int GeneralN, int ArmorN>
+bool BasicInventory<GeneralN, ArmorN>::canStack(const Item& a, const Item& b) const {
     if (!isStackable(a) || !isStackable(b))
     return false;
 
-    if (a.getName() != b.getName())
-    return false;
-
-    return typeid(a) == typeid(b);
+    return &a.getDefinition() == &b.getDefinition();
 }
-void Inventory::mergeStacks(Item& target, Item& source) {
+template <int GeneralN, int ArmorN>
+void BasicInventory<GeneralN, ArmorN>::mergeStacks(Item& target, Item& source) {
     int space = target.getMaxStack() - target.getStackCount();
     int amount = std::min(space, source.getStackCount());
 
     target.addToStack(amount);
     source.removeFromStack(amount);
 }
-int Inventory::findFirstEmptyGeneralSlot() const {
-    for (int i = 0; i < GeneralSlots.size(); ++i) {
-        if (!GeneralSlots[i])
-        return i;
+template <int GeneralN, int ArmorN>
+int BasicInventory<GeneralN, ArmorN>::findFirstEmptyGeneralSlot() const {
+    for (size_t w = 0; w < FreeSlots.size(); ++w) {
+        if (FreeSlots[w])
+        return static_cast<int > (w * 64) + lowestSetBit(FreeSlots[w]);
     }
 
     return - 1;
 }
-int Inventory::findStackableSlot(const Item& item) const {
-    for (int i = 0; i < GeneralSlots.size(); ++i) {
-        if (GeneralSlots[i] && canStack(*GeneralSlots[i], item))
-        return i;
-    }
+template <int GeneralN, int ArmorN>
+int BasicInventory<GeneralN, ArmorN>::findStackableSlot(const Item& item) const {
+    if (!isStackable(item))
+    return -1;
 
+    auto it = OpenStacks.find(stackKey(item));
+    if (it == OpenStacks.end() || it->second.empty())
     return -1;
+
+    return it->second.front();
 }
-StatBoosts Inventory::getStatBoosts() const {
-	StatBoosts boosts;
-	
-	for (int i = 0; i < ArmorSlots.size(); i++) {
-		const Armor* a = dynamic_cast<const Armor*>(ArmorSlots[i].get());
-		if (a) {
-			boosts.health += a->getHealthBoost();
-			boosts.defense += a->getDefense();
-		}
+template <int GeneralN, int ArmorN>
+unsigned long long BasicInventory<GeneralN, ArmorN>::stackKey(const Item& item) {
+    return (static_cast<unsigned long long > (item.getKind()) << 32) | static_cast<unsigned > (item.getItemID());
+}
+template <int GeneralN, int ArmorN>
+void BasicInventory<GeneralN, ArmorN>::unindexSlot(int Index) {
+    const Item* item = GeneralSlots[Index].get();
+    if (!item || !isStackable(*item))
+    return;
+
+    auto it = OpenStacks.find(stackKey(*item));
+    if (it == OpenStacks.end())
+    return;
+
+    auto& slots = it->second;
+    auto pos = std::find(slots.begin(), slots.end(), Index);
+    if (pos != slots.end())
+    slots.erase(pos);
+}
+template <int GeneralN, int ArmorN>
+void BasicInventory<GeneralN, ArmorN>::indexSlot(int Index) {
+    const Item* item = GeneralSlots[Index].get();
+    unsigned long long bit = 1ULL << (Index % 64);
+    ContentVersion++; // Every change to a general slot ends here
+
+    if (!item) {
+        FreeSlots[Index / 64] |= bit;
+        return;
+    }
+
+    FreeSlots[Index / 64] &= ~bit;
+
+    if (!isStackable(*item) || item->getStackCount() >= item->getMaxStack())
+    return;
+
+    auto& slots = OpenStacks[stackKey(*item)];
+    slots.insert(std::lower_bound(slots.begin(), slots.end(), Index), Index);
+}
+template <int GeneralN, int ArmorN>
+const StatBoosts& BasicInventory<GeneralN, ArmorN>::getStatBoosts() const {
+	return EquipmentStats;
+}
+template <int GeneralN, int ArmorN>
+unsigned BasicInventory<GeneralN, ArmorN>::getEquipmentVersion() const {
+	return EquipmentVersion;
+}
+template <int GeneralN, int ArmorN>
+unsigned BasicInventory<GeneralN, ArmorN>::getContentVersion() const {
+	return ContentVersion;
+}
+template <int GeneralN, int ArmorN>
+void BasicInventory<GeneralN, ArmorN>::refreshEquipmentStats() {
+	EquipmentStats = StatBoosts();
+	applyEquipmentStats(WeaponSlot.get(), 1);
+	for (auto& armor : ArmorSlots)
+	applyEquipmentStats(armor.get(), 1);
+
+	EquipmentVersion++;
+}
+template <int GeneralN, int ArmorN>
+void BasicInventory<GeneralN, ArmorN>::applyEquipmentStats(const Item* item, int sign) {
+	if (!item)
+	return;
+
+	switch (item->getKind()) {
+		case ItemKind::Weapon:
+			EquipmentStats.damage += sign * item->asWeapon()->getDamage();
+			break;
+		case ItemKind::Armor:
+			EquipmentStats.health += sign * item->asArmor()->getHealthBoost();
+			EquipmentStats.defense += sign * item->asArmor()->getDefense();
+			break;
+		default:
+			return;
 	}
-	
-	return boosts;
+
+	EquipmentVersion++;
+	ContentVersion++; // Equip and unequip both come through here
 }
 
+// Inventory Instantiations, add new container sizes here
+template class BasicInventory<30, 4>;
+template class BasicInventory<10, 0>;
+template class BasicInventory<DynamicSlots, 0>;
+
 // Weapon Functions
-Weapon::Weapon() {
-    MaxStack = 1;
-    StackCount = 1;
-}
+Weapon::Weapon(const ItemDefinition* def) : Item(def) {}
 ItemActionResult Weapon::use() { return equip(); }
-int Weapon::getDamage() const { return Damage; }
+int Weapon::getDamage() const { return Def->Damage; }
 ItemActionResult Weapon::equip() {
     ItemActionResult r;
     r.success = true;
@@ -242,122 +580,187 @@ ItemActionResult Weapon::equip() {
     r.isWeapon = true;
     return r;
 }
-void Weapon::setDamage(int d) { Damage = d; }
 
 // Armor Functions
-Armor::Armor() {
-    MaxStack = 1;
-    StackCount = 1;
-}
+Armor::Armor(const ItemDefinition* def) : Item(def) {}
 ItemActionResult Armor::use() { return equip(); }
 ItemActionResult Armor::equip() {
     ItemActionResult r;
     r.success = true;
     r.equipped = true;
-    r.armorSlot = Slot;
+    r.armorSlot = Def->Slot;
     return r;
 }
-void Armor::setHealthBonus(int h) { HealthBonus = h; }
-void Armor::setDefense(int d) { Defense = d; }
-void Armor::setSlot(ArmorSlotType s) { Slot = s; }
-ArmorSlotType Armor::getSlot() const { return Slot; }
-int Armor::getDefense() const { return Defense; }
-int Armor::getHealthBoost() const { return HealthBonus; }
+ArmorSlotType Armor::getSlot() const { return Def->Slot; }
+int Armor::getDefense() const { return Def->Defense; }
+int Armor::getHealthBoost() const { return Def->HealthBonus; }
 
 // Potion Functions
-Potion::Potion() {
-    MaxStack = 10;
-    StackCount = 1;
-}
+Potion::Potion(const ItemDefinition* def) : Item(def) {}
 ItemActionResult Potion::use() { return consume(); }
 ItemActionResult Potion::consume() {
     ItemActionResult r;
     r.success = true;
-    r.healAmount = HealAmount;
-    r.removeDebuffs = Removes;
+    r.healAmount = Def->HealAmount;
+    r.removeDebuffs = Def->Removes;
     return r;
 }
-void Potion::setHealAmount(int h) { HealAmount = h; }
+int Potion::getHealAmount() const { return Def->HealAmount; }
 
 // ItemFactory Functions
-std::vector < std::unique_ptr < Item>> ItemFactory::loadItems(const std::string& filename) {
-    std::vector < std::unique_ptr < Item>> items;
-    std::ifstream file(filename);
+std::vector < ItemPtr > ItemFactory::loadItems(const std::string& filename) {
+    std::vector < const ItemDefinition* > defs = loadDefinitions(filename);
+    std::vector < ItemPtr > items;
+    items.reserve(defs.size());
+    for (const ItemDefinition* def : defs) items.push_back(createItem(def));
+    return items;
+}
+std::vector < ItemPtr > ItemFactory::loadItems(const GameDataFile& data) {
+    std::vector < const ItemDefinition* > defs = loadDefinitions(data);
+    std::vector < ItemPtr > items;
+    items.reserve(defs.size());
+    for (const ItemDefinition* def : defs) items.push_back(createItem(def));
+    return items;
+}
+std::vector < const ItemDefinition* > ItemFactory::loadDefinitions(const std::string& filename) {
+    std::vector < const ItemDefinition* > added;
+    std::string buffer;
+    Diagnostics.clear();
 
-    if (!file) {
+    if (!readTextFile(filename, buffer)) {
         std::cerr << "Failed to open item file: " << filename << "\n";
-        return items;
+        return added;
     }
 
-    std::vector < std::string > block;
-    std::string line;
+    auto defs = parseItems(buffer, Diagnostics);
+    Registry.reserve(static_cast<int > (defs.size()));
+    added.reserve(defs.size());
 
-    while (std::getline(file, line)) {
-        if (line.find("-----------") != std::string::npos) {
-            if (!block.empty()) {
-                auto item = parseItemBlock(block);
-                if (item) items.push_back(std::move(item));
-                block.clear();
-            }
-        } else if (!line.empty()) {
-            block.push_back(line);
-        }
+    for (auto& def : defs) {
+        added.push_back(Registry.add(std::move(def)));
     }
 
-    // Last block
-    if (!block.empty()) {
-        auto item = parseItemBlock(block);
-        if (item) items.push_back(std::move(item));
+    reportDiagnostics(filename, Diagnostics);
+    return added;
+}
+std::vector < const ItemDefinition* > ItemFactory::loadDefinitions(const GameDataFile& data) {
+    std::vector < const ItemDefinition* > added;
+    added.reserve(data.getItemCount());
+    Registry.reserve(data.getItemCount());
+    Registry.keepAlive(data.getMapping());
+
+    for (int i = 0; i < data.getItemCount(); ++i) {
+        const ItemRecord& r = data.getItem(i);
+
+        ItemDefinition* def = Registry.emplace(r.id); // Straight into the registry, nothing is allocated per record
+        def->Kind = static_cast<ItemKind > (r.kind);
+        def->Slot = static_cast<ArmorSlotType > (r.slot);
+        def->MaxStack = r.maxStack;
+        def->Damage = r.damage;
+        def->Defense = r.defense;
+        def->HealthBonus = r.healthBonus;
+        def->HealAmount = r.healAmount;
+        def->Traits = TraitSet(r.traits);
+        def->Removes = TraitSet(r.removes);
+        def->Name = data.getString(r.nameOffset, r.nameLength); // Points into the mapping
+        def->Description = data.getString(r.descOffset, r.descLength);
+        def->Text.reset();
+
+        added.push_back(def);
     }
 
-    return items;
+    return added;
+}
+ItemPtr ItemFactory::createItem(int id, int count) const {
+    const ItemDefinition* def = Registry.find(id);
+    if (!def)
+    return nullptr;
+
+    return createItem(def, count);
+}
+ItemPtr ItemFactory::createItem(const ItemDefinition* def, int count) {
+    if (!def)
+    return nullptr;
+
+    ItemPtr item;
+    switch (def->Kind) {
+        case ItemKind::Weapon: item.reset(itemPool < Weapon > ().create(def)); break;
+        case ItemKind::Armor: item.reset(itemPool < Armor > ().create(def)); break;
+        case ItemKind::Potion: item.reset(itemPool < Potion > ().create(def)); break;
+        default: item.reset(itemPool < GenericItem > ().create(def)); break;
+    }
+
+    item->addToStack(count - 1);
+    return item;
+}
+const ItemRegistry& ItemFactory::getRegistry() const {
+    return Registry;
 }
-std::unique_ptr < Item > ItemFactory::parseItemBlock(const std::vector < std::string>& lines) {
+ItemRegistry& ItemFactory::getRegistry() {
+    return Registry;
+}
+const std::vector < ParseDiagnostic>& ItemFactory::getDiagnostics() const {
+    return Diagnostics;
+}
+std::vector < std::unique_ptr < ItemDefinition >> ItemFactory::parseItems(std::string_view text, std::vector < ParseDiagnostic>& diagnostics) {
+    std::vector < std::unique_ptr < ItemDefinition >> defs;
+    defs.reserve(countBlocks(text, "-----------"));
+
+    TextScanner scanner(text);
+    std::vector < TextLine > block;
+
+    while (scanner.nextBlock("-----------", block)) {
+        auto def = parseItemBlock(block, diagnostics);
+        if (def) defs.push_back(std::move(def));
+    }
+
+    return defs;
+}
+std::unique_ptr < ItemDefinition > ItemFactory::parseItemBlock(const std::vector < TextLine>& lines, std::vector < ParseDiagnostic>& diagnostics) {
     if (lines.empty())
     return nullptr;
 
     // First line: "1 - Oak Sword"
-    std::string header = lines[0];
-    auto dashPos = header.find('-');
-    if (dashPos == std::string::npos)
-    return nullptr;
+    const TextLine& header = lines[0];
+    auto dashPos = header.text.find('-');
+    if (dashPos == std::string_view::npos) {
+        diagnostics.push_back({ header.number, 1, "expected 'ID - Name'" });
+        return nullptr;
+    }
 
-    int itemID = std::stoi(header.substr(0, dashPos));
-    std::string name = header.substr(dashPos + 1);
-    name.erase(0, name.find_first_not_of(" \t"));
+    int itemID = 0;
+    if (!parseInt(header, header.text.substr(0, dashPos), itemID, diagnostics))
+    return nullptr;
+    std::string_view name = trimLeftView(header.text.substr(dashPos + 1));
 
     // Parsed attributes
     int damage = 0;
     int defense = 0;
     int health = 0;
     int healing = 0;
-	std::string description;
+	std::string_view description;
 
     ArmorSlotType armorSlot = ArmorSlotType::Coat; // default fallback
     bool hasArmorSlot = false;
 
-    std::vector < Trait > traits;
+    TraitSet traits;
 
     // Parse remaining lines
     for (size_t i = 1; i < lines.size(); ++i) {
-        std::string line = lines[i];
+        std::string_view line = trimLeftView(lines[i].text);
         if (line.empty())
         continue;
 
-        // Trim leading whitespace
-        line.erase(0, line.find_first_not_of(" \t"));
-
         // Stat lines contain a colon
         auto colon = line.find(':');
-        if (colon != std::string::npos) {
-            std::string key = line.substr(0, colon);
-            std::string value = line.substr(colon + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-
-            if (key == "Damage") damage = std::stoi(value);
-            else if (key == "Defense") defense = std::stoi(value);
-            else if (key == "Health") health = std::stoi(value);
-            else if (key == "Healing") healing = std::stoi(value);
+        if (colon != std::string_view::npos) {
+            std::string_view key = line.substr(0, colon);
+            std::string_view value = trimLeftView(line.substr(colon + 1));
+
+            if (key == "Damage") parseInt(lines[i], value, damage, diagnostics);
+            else if (key == "Defense") parseInt(lines[i], value, defense, diagnostics);
+            else if (key == "Health") parseInt(lines[i], value, health, diagnostics);
+            else if (key == "Healing") parseInt(lines[i], value, healing, diagnostics);
 			else if (key == "Description") description = value;
 
             continue;
@@ -381,61 +784,50 @@ std::unique_ptr < Item > ItemFactory::parseItemBlock(const std::vector < std::st
             hasArmorSlot = true;
         }
         else if (line == "Equippable") {
-            traits.push_back(Trait::Equipable);
+            traits.add(Trait::Equipable);
         }
         else if (line == "Consumable") {
-            traits.push_back(Trait::Consumable);
+            traits.add(Trait::Consumable);
         }
     }
 
     // Decide item type
+    auto def = std::make_unique < ItemDefinition > ();
+    def->ItemID = itemID;
+    def->setText(name, description);
+    def->Traits = traits;
+
     if (damage > 0) {
-        auto w = std::make_unique < Weapon > ();
-        w->setItemID(itemID);
-        w->setName(name);
-        w->setDescription(description);
-        w->setDamage(damage);
-        w->setTraits(traits);
-        return w;
+        def->Kind = ItemKind::Weapon;
+        def->MaxStack = 1;
+        def->Damage = damage;
+        return def;
     }
 
     if (defense > 0 || health > 0) {
-        auto a = std::make_unique < Armor > ();
-        a->setItemID(itemID);
-        a->setName(name);
-        a->setDescription(description);
-        a->setDefense(defense);
-        a->setHealthBonus(health);
-        a->setTraits(traits);
-        a->setSlot(armorSlot);
-
-        return a;
+        def->Kind = ItemKind::Armor;
+        def->MaxStack = 1;
+        def->Defense = defense;
+        def->HealthBonus = health;
+        def->Slot = armorSlot;
+        return def;
     }
 
     if (healing > 0) {
-        auto p = std::make_unique < Potion > ();
-        p->setItemID(itemID);
-        p->setName(name);
-        p->setDescription(description);
-        p->setHealAmount(healing);
-        p->setTraits(traits);
-        return p;
+        def->Kind = ItemKind::Potion;
+        def->MaxStack = 10;
+        def->HealAmount = healing;
+        return def;
     }
 
-    auto g = std::make_unique < GenericItem > ();
-    g->setItemID(itemID);
-    g->setName(name);
-    g->setDescription(description);
-    g->setTraits(traits);
-    return g;
+    def->Kind = ItemKind::Generic;
+    def->MaxStack = 100;
+    return def;
 }
 
 // Generic Item Functions
 
-GenericItem::GenericItem() {
-    MaxStack = 100;
-    StackCount = 1;
-}
+GenericItem::GenericItem(const ItemDefinition* def) : Item(def) {}
 ItemActionResult GenericItem::use() {
     ItemActionResult r;
     r.success = true;
@@ -2,29 +2,58 @@
 # define RPG_INVENTORY_SYSTEM_HPP
 
 # include <string>
+# include <string_view>
 # include <vector>
 # include <memory>
 # include <array>
+# include <unordered_map>
+# include <type_traits>
+# include "TextParser.hpp"
 
 // Class and Structure Declarations
+class GameDataFile;
+class Item;
+class Weapon;
+class Armor;
+class Potion;
 enum class ArmorSlotType {
     Helmet,
     Coat,
     Pants,
     Boots
 };
+enum class ItemKind : unsigned char {
+    Generic,
+    Weapon,
+    Armor,
+    Potion
+};
 enum class Trait {
     Fire,
     Poison,
     Consumable,
     Equipable
 };
+constexpr int TraitCount = 4;
+class TraitSet { // One bit per Trait, the same bits GameData.bin stores
+    public:
+    TraitSet() = default;
+    explicit TraitSet(unsigned char bits) : Bits(bits) {}
+
+    void add(Trait t) { Bits |= static_cast<unsigned char > (1u << static_cast<int > (t)); }
+    bool has(Trait t) const { return (Bits >> static_cast<int > (t)) & 1u; }
+    bool empty() const { return Bits == 0; }
+    unsigned char getBits() const { return Bits; }
+
+    private:
+    unsigned char Bits = 0;
+};
 struct ItemActionResult {
     bool success = false;
 
     // Potions
     int healAmount = 0;
-    std::vector < Trait > removeDebuffs;
+    TraitSet removeDebuffs;
 
     // Equipment
     bool equipped = false;
@@ -37,12 +66,77 @@ struct ItemActionResult {
 struct StatBoosts {
 	int health = 0;
 	int defense = 0;
+	int damage = 0; // Equipped weapon damage, 0 when unarmed
 };
+// Everything about an item that never changes during play, shared by every instance with the same ItemID (hot reload patches it in place)
+struct ItemDefinition {
+    int ItemID = -1;
+    ItemKind Kind = ItemKind::Generic;
+    std::string_view Name; // Into Text, or into the compiled file the registry keeps mapped
+    std::string_view Description;
+    TraitSet Traits;
+    int MaxStack = 1;
+
+    // Kind specific stats
+    int Damage = 0;
+    int Defense = 0;
+    int HealthBonus = 0;
+    int HealAmount = 0;
+    TraitSet Removes;
+    ArmorSlotType Slot = ArmorSlotType::Coat;
+
+    std::unique_ptr < char[] > Text; // Name and Description when they were parsed or built at runtime
+    void setText(std::string_view name, std::string_view description); // Copies both into Text
+};
+class ItemRegistry {
+    public:
+    // Re-adding an ID overwrites the existing definition in place, so live items keep a valid pointer
+    const ItemDefinition* add(std::unique_ptr < ItemDefinition > def);
+    ItemDefinition* emplace(int id); // The definition to fill in for id, a blank one if it is new
+    const ItemDefinition* find(int id) const;
+    int size() const;
+    void reserve(int count);
+    std::vector < const ItemDefinition* > getDefinitions() const; // Sorted by ItemID
+    void keepAlive(std::shared_ptr < const void > storage); // Memory that definitions point their strings into
+
+    private:
+    struct Slot {
+        int id = 0;
+        ItemDefinition* def = nullptr; // nullptr = empty
+    };
+
+    // Definitions live in blocks that never move, found through an open addressing table
+    std::vector < std::unique_ptr < ItemDefinition[] >> Blocks;
+    int BlockUsed = 0;
+    int BlockCapacity = 0;
+    std::vector < Slot > Table; // Power of two, at most half full
+    int TableShift = 64;
+    int Count = 0;
+    std::vector < std::shared_ptr < const void >> Storage;
+
+    size_t findSlot(int id) const;
+    void growTable(int count);
+};
+// Items come out of per-kind slab pools, ItemPtr hands them back to the right pool on destruction.
+// The pools are not thread safe, create and destroy items on the game thread.
+struct ItemPoolStats {
+    long long allocations = 0;
+    long long releases = 0;
+    long long live = 0;
+    long long slabs = 0; // Every slab is one trip to the global allocator
+    long long capacity = 0;
+};
+struct ItemDeleter {
+    void operator()(Item* item) const;
+};
+using ItemPtr = std::unique_ptr < Item, ItemDeleter >;
+
+ItemPoolStats getItemPoolStats(ItemKind kind);
+void reserveItemPool(ItemKind kind, int count); // Grow ahead of time so loot bursts don't hit the allocator
+
 class Item {
     public:
-    void setName(const std::string& n);
-    void setDescription(const std::string& d);
-    void setTraits(const std::vector < Trait>& t);
+    explicit Item(const ItemDefinition* def);
 
     void addToStack(int amount);
     void removeFromStack(int amount);
@@ -50,35 +144,45 @@ class Item {
     virtual ItemActionResult use() = 0;
     virtual ~Item() = default;
 
-    const std::string& getName() const;
-    const std::string& getDescription() const;
-    const std::vector < Trait>& getTraits() const;
+    const ItemDefinition& getDefinition() const { return *Def; }
+    std::string_view getName() const;
+    std::string_view getDescription() const;
+    TraitSet getTraits() const;
     int getStackCount() const;
     int getMaxStack() const;
-
-    void setItemID(int id);
     int getItemID() const;
 
+    // Kind tag, checked with a compare instead of dynamic_cast
+    ItemKind getKind() const { return Kind; }
+    Weapon* asWeapon();
+    const Weapon* asWeapon() const;
+    Armor* asArmor();
+    const Armor* asArmor() const;
+    Potion* asPotion();
+    const Potion* asPotion() const;
+
     protected:
-    std::string Name;
-    std::string Description;
-    std::vector < Trait > Traits;
+    const ItemDefinition* Def; // Owned by an ItemRegistry that must outlive the item
     int StackCount = 1;
-    int MaxStack = 1;
-
-    private:
-    int ItemID = -1;
+    ItemKind Kind;
 };
-class Inventory {
+// Slot storage is a std::array for fixed sizes and a std::vector when GeneralN is DynamicSlots,
+// everything else (stacking, moving, equipping) is shared. Members are defined in
+// RPG_Inventory_System.cpp and instantiated there for the sizes below.
+constexpr int DynamicSlots = -1;
+
+template <int GeneralN, int ArmorN>
+class BasicInventory {
     public:
-    Inventory();
+    explicit BasicInventory(int GeneralSlotCount = (GeneralN > 0 ? GeneralN : 0)); // Count only matters for DynamicSlots
 
-    bool addItem(std::unique_ptr < Item > item);
-    std::unique_ptr < Item > removeItem(int SlotIndex);
+    bool addItem(ItemPtr item);
+    ItemPtr removeItem(int SlotIndex);
+    bool removeFromStack(int SlotIndex, int amount); // Use this rather than Item::removeFromStack so the stack index stays right
     bool moveItem(int from, int to);
     bool equipItem(int SlotIndex);
-    std::unique_ptr < Item > unequipWeapon();
-    std::unique_ptr < Item > unequipArmor(ArmorSlotType type);
+    ItemPtr unequipWeapon();
+    ItemPtr unequipArmor(ArmorSlotType type);
     Item* getItem(int SlotIndex);
 	const Item* getItem(int SlotIndex) const;
     bool isSlotEmpty(int SlotIndex) const;
@@ -86,14 +190,31 @@ class Inventory {
     const Item* getEquippedArmor(ArmorSlotType type) const;
     int getGeneralSlotCount() const;
     int getArmorSlotCount() const;
-	StatBoosts getStatBoosts() const;
+	const StatBoosts& getStatBoosts() const;
+	unsigned getEquipmentVersion() const; // Bumped whenever the equipped stats change
+	unsigned getContentVersion() const; // Bumped whenever any slot, equipped ones included, changes what it holds
+	void refreshEquipmentStats(); // Recounts the equipped stats, for when definitions change underneath the items
 
     private:
-    std::array < std::unique_ptr < Item >,
-    30 > GeneralSlots;
-    std::unique_ptr < Item > WeaponSlot;
-    std::array < std::unique_ptr < Item >,
-    4 > ArmorSlots;
+    template < typename T, int N >
+    using SlotStorage = std::conditional_t < N == DynamicSlots,
+    std::vector < T >,
+    std::array < T, (N > 0 ? N : 0) >>;
+
+    SlotStorage < ItemPtr,
+    GeneralN > GeneralSlots;
+    ItemPtr WeaponSlot;
+    std::array < ItemPtr,
+    ArmorN > ArmorSlots;
+    StatBoosts EquipmentStats; // Kept in sync by equip/unequip so nobody has to walk the slots
+    unsigned EquipmentVersion = 0;
+    unsigned ContentVersion = 0;
+
+    // Slot indexes, kept in sync by every function that touches GeneralSlots
+    SlotStorage < unsigned long long,
+    (GeneralN == DynamicSlots ? DynamicSlots : (GeneralN + 63) / 64) > FreeSlots; // Bit set = slot is empty
+    std::unordered_map < unsigned long long,
+    std::vector < int >> OpenStacks; // Stack key -> slots holding that item with room left, lowest first
 
     bool isValidGeneralSlot(int Index) const;
     bool isValidArmorSlot(ArmorSlotType type) const;
@@ -105,60 +226,75 @@ class Inventory {
     void mergeStacks(Item& target, Item& source);
     int findFirstEmptyGeneralSlot() const;
     int findStackableSlot(const Item& item) const;
+    void applyEquipmentStats(const Item* item, int sign);
+    static unsigned long long stackKey(const Item& item);
+    void unindexSlot(int Index);
+    void indexSlot(int Index);
 };
+using Inventory = BasicInventory < 30, 4 >; // The player's bag
+using ChestInventory = BasicInventory < 10, 0 >;
+using DynamicInventory = BasicInventory < DynamicSlots, 0 >; // Bank vaults and shop stock, sized at runtime
+
 class Weapon: public Item {
     public:
-    Weapon();
+    explicit Weapon(const ItemDefinition* def);
 
     ItemActionResult use() override;
     ItemActionResult equip();
-    void setDamage(int d);
 	int getDamage() const;
-
-    private:
-    int Damage;
 };
 class Potion: public Item {
     public:
-    Potion();
+    explicit Potion(const ItemDefinition* def);
 
     ItemActionResult use() override;
     ItemActionResult consume();
-    void setHealAmount(int h);
-
-    private:
-    int HealAmount = 0;
-    std::vector < Trait > Removes;
+    int getHealAmount() const;
 };
 class Armor: public Item {
     public:
-    Armor();
+    explicit Armor(const ItemDefinition* def);
 
     ItemActionResult use() override;
     ItemActionResult equip();
-    void setHealthBonus(int h);
-    void setDefense(int d);
-    void setSlot(ArmorSlotType s);
     ArmorSlotType getSlot() const;
 	int getDefense() const;
 	int getHealthBoost() const;
-
-    private:
-    int Defense;
-    int HealthBonus;
-    ArmorSlotType Slot;
 };
 class ItemFactory {
     public:
-    std::vector < std::unique_ptr < Item>> loadItems(const std::string& filename);
+    // Registers every definition in the file and hands back one instance of each
+    std::vector < ItemPtr > loadItems(const std::string& filename);
+    std::vector < ItemPtr > loadItems(const GameDataFile& data); // Compiled GameData.bin, no parsing
+    // Same, but only registers the definitions, so it makes no items and can run off the game thread
+    std::vector < const ItemDefinition* > loadDefinitions(const std::string& filename);
+    std::vector < const ItemDefinition* > loadDefinitions(const GameDataFile& data);
+    ItemPtr createItem(int id, int count = 1) const;
+    static ItemPtr createItem(const ItemDefinition* def, int count = 1);
+    const ItemRegistry& getRegistry() const;
+    ItemRegistry& getRegistry();
+    const std::vector < ParseDiagnostic>& getDiagnostics() const; // From the last text load, also printed to std::cerr
+
+    // Parses without touching the registry, safe to call from several threads at once
+    static std::vector < std::unique_ptr < ItemDefinition >> parseItems(std::string_view text, std::vector < ParseDiagnostic>& diagnostics);
 
     private:
-    std::unique_ptr < Item > parseItemBlock(const std::vector < std::string>& lines);
+    ItemRegistry Registry; // Items point into this, so keep the factory alive as long as its items
+    std::vector < ParseDiagnostic > Diagnostics;
+    static std::unique_ptr < ItemDefinition > parseItemBlock(const std::vector < TextLine>& lines, std::vector < ParseDiagnostic>& diagnostics);
 };
 class GenericItem: public Item {
     public:
-    GenericItem();
+    explicit GenericItem(const ItemDefinition* def);
     ItemActionResult use() override;
 };
 
+// Inline Item Accessors
+inline Weapon* Item::asWeapon() { return Kind == ItemKind::Weapon ? static_cast<Weapon*>(this) : nullptr; }
+inline const Weapon* Item::asWeapon() const { return Kind == ItemKind::Weapon ? static_cast<const Weapon*>(this) : nullptr; }
+inline Armor* Item::asArmor() { return Kind == ItemKind::Armor ? static_cast<Armor*>(this) : nullptr; }
+inline const Armor* Item::asArmor() const { return Kind == ItemKind::Armor ? static_cast<const Armor*>(this) : nullptr; }
+inline Potion* Item::asPotion() { return Kind == ItemKind::Potion ? static_cast<Potion*>(this) : nullptr; }
+inline const Potion* Item::asPotion() const { return Kind == ItemKind::Potion ? static_cast<const Potion*>(this) : nullptr; }
+
 #endif
\ No newline at end of file
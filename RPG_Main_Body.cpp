@@ -3,6 +3,7 @@
 # include <SDL2/SDL_ttf.h>
 # include <iostream>
 # include <fstream>
+# include <cstdio>
 # include <chrono>
 # include <thread>
 # include <cmath>
@@ -10,16 +11,26 @@
 # include <vector>
 # include <array>
 # include <unordered_map>
+# include <charconv>
 # include "RPG_Inventory_System.hpp"
 # include "NPCs.hpp"
 # include "render2d.hpp"
+# include "Player.hpp"
+# include "Combat.hpp"
+# include "GameData.hpp"
+# include "ContentPack.hpp"
+# include "HotReload.hpp"
+# include "GameClock.hpp"
+# include "Profiler.hpp"
+# include "WorldEntities.hpp"
+# include "WorldStream.hpp"
+# include "AudioMixer.hpp"
+# include "JobSystem.hpp"
 
 // Initial Global Declaration
 enum class GameState;
-enum class CombatState;
 struct InventorySlotInfo;
-struct CombatContext;
-class Player;
+struct GameOptions;
 
 // Structures and Classes
 enum class GameState {
@@ -29,13 +40,6 @@ enum class GameState {
     Inventory
 };
 GameState state = GameState::Explore;
-enum class CombatState {
-    PlayerTurn,
-    EnemyTurn,
-    Victory,
-    Defeat,
-    WaitingForInput
-};
 struct InventorySlotInfo {
 	int slotIndex;
 	bool isEmpty;
@@ -43,162 +47,21 @@ struct InventorySlotInfo {
 	int stackCount;
 	int itemID;
 };
-struct CombatContext {
-    Player* player;
-    EnemyNPC* enemy;
-    
-    int enemyHealth;
-    int playerHealth;
-    
-    CombatState state = CombatState::PlayerTurn;
-    
-    int pendingDamage = 0; // for UI feedback
-    int lastDamage = 0; // for UI feedback
-    
-    bool playerActed = false;
-};
-class Player {
-    public:
-		static const int MAX_LEVEL = 25;
-		
-        // Position
-        int x = 0;
-        int y = 0;
-        int spawnX = 0;
-        int spawnY = 0;
-        
-        // Stats
-        int health = 100;
-        int maxHealth = 100;
-		int Defense = 0;
-        int gold = 0;
-        int xp = 0;
-        int level = 0;
-        
-        // Leveling System
-        std::vector<int> xpThresholds;
-        
-        // Inventory
-        Inventory inventory;
-        
-        // Constructor
-        Player() {
-            generateXPtable();
-        }
-        
-        // XP table generation
-        void generateXPtable() {
-            xpThresholds.clear();
-			xpThresholds.resize(MAX_LEVEL + 1);
-			
-            xpThresholds[0] = 0;
-			xpThresholds[1] = 10;
-            
-            for (int i = 1; i < MAX_LEVEL; ++i) {
-                int prev = xpThresholds[i];
-                int next = std::ceil(prev + std::log2(prev));
-                xpThresholds[i + 1] = next;
-            }
-        }
-        
-        // XP Gain
-        void addXP(int amount) {
-            xp += amount;
-            
-			if (level == MAX_LEVEL) {
-				xp = std::min(xp, xpThresholds[MAX_LEVEL]);
-			}
-			
-            while (level < MAX_LEVEL && xp >= xpThresholds[level + 1]) {
-                xp -= xpThresholds[level + 1];
-                level++;
-                onLevelUp();
-            }
-        }
-        
-        // Level Up Rewards
-        void onLevelUp() {
-            maxHealth += 10;
-            health = maxHealth;
-			if (level >= MAX_LEVEL) return;
-        }
-        
-        // Death Penalty
-        void applyDeathPenalty() {
-            // Reset and charge the player for death
-            xp = 0;
-            gold = std::max(0, gold - 100);
-            
-            // Spawn at the start
-			health = maxHealth;
-            x = spawnX;
-            y = spawnY;
-        }
-        
-        // Movement
-        void move(int dx, int dy) {
-            x += dx;
-            y += dy;
-        }
-		
-		// Finding Potion Slot for Battle Consumption
-		int findFirstPotionSlot() const {
-			for (int i = 0; i < inventory.getGeneralSlotCount(); ++i) {
-				const Item* it = inventory.getItem(i);
-				if (it && dynamic_cast<const Potion*>(it)) {
-					return i;
-				}
-			}
-			return - 1;
-		}
-		
-		// Consuming Potion During Battle
-		bool consumePotion(int slot) {
-			Item* it = inventory.getItem(slot);
-			Potion* potion = dynamic_cast<Potion*>(it);
-			if (!potion) return false;
-			
-			ItemActionResult r = potion->use();
-			
-			if (r.success) {
-				health = std::min(maxHealth, health + r.healAmount);
-				potion->removeFromStack(1);
-				if (potion->getStackCount() <= 0) {
-					inventory.removeItem(slot);
-				}
-				
-				return true;
-			}
-			
-			return false;
-		}
-		
-		int getAttackDamage() const {
-			const Weapon* w = dynamic_cast<const Weapon*>(inventory.getEquippedWeapon());
-			if (w) return w->getDamage();
-			return 1; // Unarmed Damage
-		}
-		
-		void recalculateStats() {
-			int baseHealth = 100 + level * 10;
-			int baseDefense = 0;
-			
-			auto boosts = inventory.getStatBoosts();
-			
-			maxHealth = baseHealth + boosts.health;
-			Defense = baseDefense + boosts.defense;
-			
-			if (health > maxHealth)
-				health = maxHealth;
-		}
+struct GameOptions {
+	bool watchContent = false; // --watch, hot reload ItemList.txt and NPCs.txt
+	bool renderStats = false; // --render-stats, print draw call counts about once a second
+	bool vsync = false; // --vsync
+	bool mute = false; // --mute, don't open an audio device
+	int tickRate = 60; // --tick-rate N, simulation steps per second
+	int maxFPS = 60; // --fps N, 0 for no limit; defaults to 0 with --vsync
+	std::string worldDir = "World"; // --world DIR, world.txt and the chunk files
 };
 
 // Initial function declarations
-void runGame();
+void runGame(const GameOptions& options);
 void test_inventory();
 std::vector<InventorySlotInfo> showInventory(Inventory& inv);
 void explore(Player& player);
-void fight(CombatContext* ctx, int playerChoice);
 void handleDeath(Player& player);
 std::vector<InventorySlotInfo> getInventoryInfo(Inventory& inv);
 
@@ -210,7 +73,7 @@ void test_inventory() {
     Inventory inv;
 
     // Load items from file
-    std::vector<std::unique_ptr<Item>> items = factory.loadItems("ItemList.txt");
+    std::vector<ItemPtr> items = factory.loadItems("ItemList.txt");
     std::cout << "Loaded " << items.size() << " items from file.\n\n";
 
     // Print loaded items
@@ -223,8 +86,8 @@ void test_inventory() {
                   << "/" << it->getMaxStack() << ")";
 
         std::cout << " [Traits:";
-        for (auto t : it->getTraits())
-            std::cout << " " << static_cast<int>(t);
+        for (int t = 0; t < TraitCount; ++t)
+            if (it->getTraits().has(static_cast<Trait>(t))) std::cout << " " << t;
         std::cout << "]\n";
     }
 
@@ -247,7 +110,7 @@ void test_inventory() {
     std::cout << "\n=== Equipping First Weapon ===\n";
     for (int i = 0; i < inv.getGeneralSlotCount(); ++i) {
         Item* it = inv.getItem(i);
-        if (it && dynamic_cast<const Weapon*>(it)) {
+        if (it && it->getKind() == ItemKind::Weapon) {
             std::cout << "Equipping weapon from slot " << i << "\n";
             inv.equipItem(i);
             break;
@@ -258,7 +121,7 @@ void test_inventory() {
     std::cout << "\n=== Equipping Armor ===\n";
     for (int i = 0; i < inv.getGeneralSlotCount(); ++i) {
         Item* it = inv.getItem(i);
-        if (it && dynamic_cast<const Armor*>(it)) {
+        if (it && it->getKind() == ItemKind::Armor) {
             std::cout << "Equipping armor from slot " << i << "\n";
             inv.equipItem(i);
         }
@@ -285,7 +148,7 @@ void test_inventory() {
     std::cout << "\n=== Using First Potion ===\n";
     for (int i = 0; i < inv.getGeneralSlotCount(); ++i) {
         Item* it = inv.getItem(i);
-        if (it && dynamic_cast<Potion*>(it)) {
+        if (it && it->getKind() == ItemKind::Potion) {
             std::cout << "Using potion in slot " << i << "\n";
             it->use();
             break;
@@ -294,7 +157,7 @@ void test_inventory() {
 
     std::cout << "\n=== Test Complete ===\n";
 }
-void test_items(Player& player, std::vector<std::unique_ptr<Item>>& items) {
+void test_items(Player& player, std::vector<ItemPtr>& items) {
 	
 	for (size_t i = 1; i < items.size(); ++i) {
 		if (items[i])
@@ -304,19 +167,57 @@ void test_items(Player& player, std::vector<std::unique_ptr<Item>>& items) {
 }
 
 // Functions
-void runGame() {
+void runGame(const GameOptions& options) {
+	ItemFactory itemfactory; // Owns the item definitions, so it has to outlive the player's items
     Player player;
-	ItemFactory itemfactory;
 	NPCFactory npcfactory;
 	Renderer renderer;
 	CombatContext combat;
 	combat.player = &player;
 	
-	auto items = itemfactory.loadItems("ItemList.txt");
-	auto npcs = npcfactory.loadNPCs("NPCs.txt");
+	// Prefer the compiled content when it is newer than the text files it came from.
+	// Items and NPCs don't share anything, so the item definitions load as a job while this thread does the NPCs.
+	// The items themselves are made here afterwards, the item pools belong to the game thread
+	std::vector<const ItemDefinition*> itemDefs;
+	std::unordered_map<int, std::unique_ptr<NPC>> npcs;
+	GameDataFile gamedata;
+	JobCounter itemsLoaded;
+	if (isGameDataFresh("GameData.bin", { "ItemList.txt", "NPCs.txt" }) && gamedata.open("GameData.bin")) {
+		jobSystem().run(itemsLoaded, [&] { itemDefs = itemfactory.loadDefinitions(gamedata); });
+		npcs = npcfactory.loadNPCs(gamedata);
+		jobSystem().wait(itemsLoaded);
+		gamedata.close();
+	} else {
+		jobSystem().run(itemsLoaded, [&] { itemDefs = itemfactory.loadDefinitions("ItemList.txt"); });
+		npcs = npcfactory.loadNPCs("NPCs.txt");
+		jobSystem().wait(itemsLoaded);
+	}
+	std::vector<ItemPtr> items;
+	items.reserve(itemDefs.size());
+	for (const ItemDefinition* def : itemDefs) items.push_back(ItemFactory::createItem(def));
+	
+	// Region and mod files in Content/ go on top of the base content
+	ContentPack pack = loadContentPack("Content", itemfactory, std::move(npcs));
+	npcs = std::move(pack.npcs);
+	if (pack.itemFiles + pack.npcFiles > 0) {
+		std::cout << "Content pack: " << pack.itemFiles << " item files, " << pack.npcFiles << " NPC files, "
+		          << pack.overrides.size() << " overrides\n";
+	}
+	
+	// --watch: designers edit the text files while the game runs
+	ContentHotReload hotreload(itemfactory, npcs);
+	hotreload.setPackContent(pack);
+	if (options.watchContent) {
+		hotreload.watchItems("ItemList.txt");
+		hotreload.watchNPCs("NPCs.txt");
+	}
 	bool eDown = false;
 	bool eWasDown = false;
 	
+	WorldEntities world; // Only the NPCs in chunks near the camera
+	ChunkStreamer chunks;
+	int combatEntity = -1; // World index of the enemy being fought
+	
 	player.inventory.addItem(std::move(items[0]));
 	test_items(player, items);
 	
@@ -336,134 +237,229 @@ void runGame() {
 		screenHeight = usable.h;
 	}
 	
-	renderer.init("The Mask RPG", screenWidth, screenHeight);
+	renderer.init("The Mask RPG", screenWidth, screenHeight, options.vsync);
+	
+	// Sound effects, the game just runs silent if there's no audio device
+	AudioMixer audio;
+	if (!options.mute && audio.init()) {
+		audio.loadGameSounds();
+		audio.start();
+		std::cout << "Audio: " << audio.getFrequency() << " Hz, " << audio.getLatencyMs() << " ms buffer\n";
+	}
+	combat.onEvent = [&](CombatEvent event) {
+		audio.play(event == CombatEvent::PlayerAttack ? SoundEffect::Swing : SoundEffect::Hit);
+	};
+	const int StepLength = 80; // Pixels walked per footstep, about one walk.wav at PlayerSpeed
+	int stepDistance = 0;
+	
+	// The world can be bigger than the window: the camera follows the player and chunks load around it
+	WorldInfo worldInfo;
+	if (chunks.open(options.worldDir)) {
+		worldInfo = chunks.getInfo();
+	} else { // Empty, one screen
+		worldInfo.width = renderer.windowWidth;
+		worldInfo.height = renderer.windowHeight;
+	}
+	Camera camera;
+	camera.w = renderer.windowWidth;
+	camera.h = renderer.windowHeight;
+	std::vector<int> visibleNPCs;
 	
 	// Correcting Spawn Position
 	player.spawnX = 0;
-	player.spawnY = renderer.windowHeight - 100;
+	player.spawnY = std::max(0, std::min(renderer.windowHeight, worldInfo.height) - 100);
 	player.y = player.spawnY;
 	
 	bool running = true;
+	int statsFrame = 0;
+	bool showProfiler = false; // F3, F4 writes profile.csv
+	std::vector<std::string> profilerLines;
+	
+	const double PlayerSpeed = 240.0; // Pixels per second, was 4 per frame at ~60 FPS
+	FixedTimestep timestep(options.tickRate);
+	FrameLimiter limiter(options.maxFPS);
+	int previousX = player.x; // Where the player was one tick ago, drawing blends towards the current position
+	int previousY = player.y;
+	double carryX = 0.0;
+	double carryY = 0.0;
 	
 	while (running) {
 	    SDL_Event e;
-	    while (SDL_PollEvent(&e)) {
-	        if (e.type == SDL_QUIT) { running = false; }
+	    {
+	        PROFILE_SCOPE(ProfilePhase::Events);
+	        while (SDL_PollEvent(&e)) {
+	            if (e.type == SDL_QUIT) { running = false; }
+	            if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) { renderer.invalidateRenderTargets(); }
+	            if (e.type == SDL_KEYDOWN && !e.key.repeat && e.key.keysym.scancode == SDL_SCANCODE_F3) { showProfiler = !showProfiler; }
+	            if (e.type == SDL_KEYDOWN && !e.key.repeat && e.key.keysym.scancode == SDL_SCANCODE_F4) {
+	                if (profiler().writeCSV("profile.csv")) std::cout << "Wrote profile.csv\n";
+	                else std::cerr << "Failed to write profile.csv\n";
+	            }
+	        }
 	    }
 		
+		if (options.watchContent && hotreload.update().changed()) {
+			player.inventory.refreshEquipmentStats();
+			player.recalculateStats();
+			renderer.invalidateTooltips();
+		}
+		
 		const Uint8* keystate = SDL_GetKeyboardState(NULL);
-		if (state == GameState::Explore) { // If Exploring "Not in inventory or fight"
-			int oldX = player.x;
-			int oldY = player.y;
-			
-			if (keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_UP]) player.move(0, -4);
-			if (keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_LEFT]) player.move(-4, 0);
-			if (keystate[SDL_SCANCODE_S] || keystate[SDL_SCANCODE_DOWN]) player.move(0, 4);
-			if (keystate[SDL_SCANCODE_D] || keystate[SDL_SCANCODE_RIGHT]) player.move(4, 0);
+		for (int ticks = timestep.advance(); ticks > 0; --ticks) { // Simulation runs a fixed number of ticks per second whatever the frame rate
+			previousX = player.x;
+			previousY = player.y;
+			
+			if (state == GameState::Explore) { // If Exploring "Not in inventory or fight"
+				PROFILE_SCOPE(ProfilePhase::Explore);
+				int oldX = player.x;
+				int oldY = player.y;
+			
+				int dirX = 0;
+				int dirY = 0;
+				if (keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_UP]) dirY -= 1;
+				if (keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_LEFT]) dirX -= 1;
+				if (keystate[SDL_SCANCODE_S] || keystate[SDL_SCANCODE_DOWN]) dirY += 1;
+				if (keystate[SDL_SCANCODE_D] || keystate[SDL_SCANCODE_RIGHT]) dirX += 1;
+			
+				// Speed is per second, whole pixels move now and the fraction carries into the next tick
+				double stepX = dirX ? dirX * PlayerSpeed * timestep.getTickSeconds() + carryX : 0.0;
+				double stepY = dirY ? dirY * PlayerSpeed * timestep.getTickSeconds() + carryY : 0.0;
+				player.move(static_cast<int>(stepX), static_cast<int>(stepY));
+				carryX = stepX - static_cast<int>(stepX);
+				carryY = stepY - static_cast<int>(stepY);
 		
-			const int playerW = 32;
-			const int playerH = 32;
-			player.x = std::max(0, std::min(player.x, renderer.windowWidth - playerW));
-			player.y = std::max(0, std::min(player.y, renderer.windowHeight - playerH));
-			
-			SDL_Rect playerRect{ player.x, player.y, 32, 32 };
-			SDL_Rect zombie{ 200, 200, 32, 32 };
-			SDL_Rect skeleton{ 300, 200, 32, 32 };
-			SDL_Rect goblin{ 400, 200, 32, 32 };
-			SDL_Rect shopkeeper{ 600, 400, 32, 32};
+				const int playerW = 32;
+				const int playerH = 32;
+				player.x = std::max(0, std::min(player.x, worldInfo.width - playerW));
+				player.y = std::max(0, std::min(player.y, worldInfo.height - playerH));
+			
+				auto StartCombatWithID = [&](int entity) {
+					int id = world.getArchetype(entity);
+					auto it = npcs.find(id);
+					if (it == npcs.end()) {
+						std::cerr << "NPC ID not found\n";
+						return;
+					}
+				
+					EnemyNPC* enemy = dynamic_cast<EnemyNPC*>(it->second.get());
+					if (!enemy) {
+						std::cerr << "NPC is not an enemy\nFix Your Code Idiot";
+						return;
+					}
 			
-			auto StartCombatWithID = [&](int id) {
-				auto it = npcs.find(id);
-				if (it == npcs.end()) {
-					std::cerr << "NPC ID not found\n";
-					return;
+					state = GameState::Combat;
+					world.setState(entity, EntityState::InCombat);
+					combatEntity = entity;
+					combat.enemy = enemy;
+					combat.enemyHealth = enemy->getHealth();
+					combat.playerHealth = player.health;
+					combat.state = CombatState::PlayerTurn;
+					combat.lastDamage = 0;
+					combat.playerActed = false;
+				};
+			
+				// Walking into anyone stops the player, walking into an enemy starts a fight
+				int touched = world.findOverlap(player.x, player.y, playerW, playerH);
+				if (touched >= 0) {
+					player.x = oldX;
+					player.y = oldY;
+					auto it = npcs.find(world.getArchetype(touched));
+					if (it != npcs.end() && it->second->getType() == NPCType::Enemy) StartCombatWithID(touched);
 				}
 				
-				EnemyNPC* enemy = dynamic_cast<EnemyNPC*>(it->second.get());
-				if (!enemy) {
-					std::cerr << "NPC is not an enemy\nFix Your Code Idiot";
-					return;
+				stepDistance += std::abs(player.x - oldX) + std::abs(player.y - oldY);
+				if (stepDistance >= StepLength) {
+					stepDistance -= StepLength;
+					audio.play(SoundEffect::Walk, 0.5f);
 				}
+			}
 			
-				state = GameState::Combat;
-				combat.enemy = enemy;
-				combat.enemyHealth = enemy->getHealth();
-				combat.playerHealth = player.health;
-				combat.state = CombatState::PlayerTurn;
-				combat.lastDamage = 0;
-				combat.playerActed = false;
-			};
+			if (state == GameState::Combat) {
+				PROFILE_SCOPE(ProfilePhase::Combat);
+				int mouseX, mouseY;
+				Uint32 mouseState = SDL_GetMouseState(&mouseX, &mouseY);
 			
-			if (SDL_HasIntersection(&playerRect, &zombie)) {
-				player.x = oldX;
-				player.y = oldY;
-				StartCombatWithID(4);
-			}
+				static bool clickWasDown = false;
 			
-			if (SDL_HasIntersection(&playerRect, &skeleton)) {
-				player.x = oldX;
-				player.y = oldY;
-				StartCombatWithID(3);
-			}
+				bool leftDown = mouseState & SDL_BUTTON(SDL_BUTTON_LEFT);
+				bool rightDown = mouseState & SDL_BUTTON(SDL_BUTTON_RIGHT);
 			
-			if (SDL_HasIntersection(&playerRect, &goblin)) {
-				player.x = oldX;
-				player.y = oldY;
-				StartCombatWithID(2);
-			}
+				if (leftDown && !clickWasDown) {
+					fight(&combat, 1);
+				}
+				if (rightDown && !clickWasDown) {
+					fight(&combat, 2);
+				}
+			
+				clickWasDown = leftDown || rightDown;
 			
-			if (SDL_HasIntersection(&playerRect, &shopkeeper)) {
-				player.x = oldX;
-				player.y = oldY;
+				if (combat.state == CombatState::EnemyTurn) {
+					enemyTurn(&combat);
+				}
+			
+				if (combat.state == CombatState::Victory) {
+					player.addXP(combat.enemy->getXP());
+					player.gold += combat.enemy->getGold();
+					SDL_Delay(500);
+					timestep.reset(); // The pause isn't game time
+					combat.state = CombatState::PlayerTurn;
+					combat.enemyHealth = combat.enemy->getHealth();
+					combat.lastDamage = 0;
+					combat.playerActed = false;
+				
+					state = GameState::Explore;
+				}
+			
+				if (combat.state == CombatState::Defeat) {
+					player.applyDeathPenalty();
+					state = GameState::Explore;
+				}
 			}
 		}
 		
 		if (keystate[SDL_SCANCODE_I]) { state = GameState::Inventory; }
 		else if (keystate[SDL_SCANCODE_ESCAPE]) { state = GameState::Explore; }
 		
+		if (state != GameState::Combat && combatEntity >= 0) { // Won, lost or walked away
+			world.setState(combatEntity, EntityState::Idle);
+			combatEntity = -1;
+		}
+		
+		double alpha = timestep.getAlpha();
+		int drawX = previousX + static_cast<int>((player.x - previousX) * alpha);
+		int drawY = previousY + static_cast<int>((player.y - previousY) * alpha);
+		camera.follow(drawX + 16, drawY + 16, worldInfo);
+		if (combatEntity < 0) chunks.update(camera, world); // Unloading renumbers NPCs, so not mid fight
+		
 	    renderer.clear();
-	    renderer.drawBackdrop();
+	    renderer.drawBackdrop(camera.x, camera.y);
 		if (state == GameState::Inventory) {
-			renderer.drawInventory();
+			PROFILE_SCOPE(ProfilePhase::Inventory);
+			int cols = 10;
+			int rows = (player.inventory.getGeneralSlotCount() + cols - 1) / cols;
+			InventoryLayout layout = renderer.inventoryLayout(cols, rows, player.inventory.getArmorSlotCount());
+			renderer.drawInventory(player.inventory, layout); // Slots and icons, one blit unless something changed
 			
 			int mouseX, mouseY;
 			SDL_GetMouseState(&mouseX, &mouseY);
 			
-			float uiScale = 0.5f;
-			int baseSlotSize = 92;
-			int slotSize = static_cast<int>(baseSlotSize * uiScale);
-			
-			int cols = 10;
-			int rows = 3;
-			
-			int totalWidth = (cols + 1) * slotSize;
-			int totalHeight = (rows + 1) * slotSize;
-			
-			int startX = (renderer.windowWidth - totalWidth) / 2;
-			int startY = (renderer.windowHeight - totalHeight) / 2;
-			
 			for (int r = 0; r < rows; r++) {
 				for (int c = 0; c < cols; c++) {
 					int slotIndex = r * cols + c;
 					const Item* item = player.inventory.getItem(slotIndex);
 					if (!item) continue;
 					
-					int x = startX + (c) * slotSize;
-					int y = startY + (r) * slotSize;
-					
-					renderer.drawItem(x, y, item->getItemID(), slotSize);
-					
 					// HOVER DETECTION
-					SDL_Rect slotRect{ x, y, slotSize, slotSize };
+					SDL_Rect slotRect = layout.generalSlot(slotIndex);
 					SDL_Point mousePoint{ mouseX, mouseY };
 					
 					eDown = keystate[SDL_SCANCODE_E];
 					
 					if (SDL_PointInRect(&mousePoint, &slotRect)) {
-						renderer.drawTooltip(item->getName(), item->getDescription(), mouseX + 16, mouseY + 16);
+						renderer.drawTooltip(item->getItemID(), item->getName(), item->getDescription(), mouseX + 16, mouseY + 16);
 						
 						if (eDown && !eWasDown) {
-							if (dynamic_cast<const Potion*>(item)) { 
+							if (item->getKind() == ItemKind::Potion) { 
 								player.consumePotion(slotIndex);
 								break;
 							} else {
@@ -479,32 +475,23 @@ void runGame() {
 			
 			const Item* weapon = player.inventory.getEquippedWeapon();
 			if (weapon) {
-				int x = startX;
-				int y = startY + rows * slotSize;
-				renderer.drawItem(x, y, weapon->getItemID(), slotSize);
-				
 				// HOVER DETECTION
-				SDL_Rect slotRect{ x, y, slotSize, slotSize };
+				SDL_Rect slotRect = layout.weaponSlot();
 				SDL_Point mousePoint{ mouseX, mouseY };
 				if (SDL_PointInRect(&mousePoint, &slotRect)) {
-					renderer.drawTooltip(weapon->getName(), weapon->getDescription(), mouseX + 16, mouseY + 16);
+					renderer.drawTooltip(weapon->getItemID(), weapon->getName(), weapon->getDescription(), mouseX + 16, mouseY + 16);
 				}
 			}
 			
-			for (int i = 0; i < 4; i ++) {
+			for (int i = 0; i < player.inventory.getArmorSlotCount(); i ++) {
 				const Item* armor = player.inventory.getEquippedArmor(static_cast<ArmorSlotType>(i));
 				if (!armor) continue;
 				
-				int x = startX - slotSize;
-				int y = startY + i * slotSize;
-				
-				renderer.drawItem(x, y, armor->getItemID(), slotSize);
-				
 				// HOVER DETECTION
-				SDL_Rect slotRect{ x, y, slotSize, slotSize };
+				SDL_Rect slotRect = layout.armorSlot(i);
 				SDL_Point mousePoint{ mouseX, mouseY };
 				if (SDL_PointInRect(&mousePoint, &slotRect)) {
-					renderer.drawTooltip(armor->getName(), armor->getDescription(), mouseX + 16, mouseY + 16);
+					renderer.drawTooltip(armor->getItemID(), armor->getName(), armor->getDescription(), mouseX + 16, mouseY + 16);
 				}
 			}
 		}
@@ -512,87 +499,44 @@ void runGame() {
 		renderer.drawPlayerUI(player.level, player.xp, player.maxHealth, player.health, player.gold, player.xpThresholds);
 		
 		if (state == GameState::Explore) { 
-			renderer.drawNPC(200, 200, 4);
-			renderer.drawNPC(300, 200, 3);
-			renderer.drawNPC(400, 200, 2);
-			renderer.drawNPC(600, 400, 1);
-			renderer.drawPlayer(player.x, player.y);
+			world.queryBox(camera.x, camera.y, camera.w, camera.h, visibleNPCs);
+			for (int i : visibleNPCs) renderer.drawNPC(world.getX(i) - camera.x, world.getY(i) - camera.y, world.getArchetype(i));
+			renderer.drawPlayer(drawX - camera.x, drawY - camera.y);
 		}
 		
-		if (state == GameState::Combat) {
-			renderer.clear();
-			renderer.drawBackdrop();
-			renderer.drawPlayerUI(player.level, player.xp, player.maxHealth, player.health, player.gold, player.xpThresholds);
-			
+		if (state == GameState::Combat) { // Backdrop and HUD were already drawn above
 			renderer.drawText("Combat!", 250, 50);
-			renderer.drawText("Enemy: " + combat.enemy->getName(), 250, 100);
+			char enemyLine[96];
+			snprintf(enemyLine, sizeof(enemyLine), "Enemy: %s", combat.enemy->getName().c_str());
+			renderer.drawText(enemyLine, 250, 100);
 			
 			int npcID = combat.enemy->getID();
 			
 			renderer.drawNPC(200, 200, npcID);
 			renderer.drawPlayer(200, 400);
-			
-			int mouseX, mouseY;
-			Uint32 mouseState = SDL_GetMouseState(&mouseX, &mouseY);
-			
-			static bool clickWasDown = false;
-			
-			bool leftDown = mouseState & SDL_BUTTON(SDL_BUTTON_LEFT);
-			bool rightDown = mouseState & SDL_BUTTON(SDL_BUTTON_RIGHT);
-			
-			if (leftDown && !clickWasDown) {
-				fight(&combat, 1);
-			}
-			if (rightDown && !clickWasDown) {
-				fight(&combat, 2);
-			}
-			
-			clickWasDown = leftDown || rightDown;
-			
-			if (combat.state == CombatState::EnemyTurn) {
-				int dmg = 0;
-				if (combat.player->Defense > 0) {
-					dmg = combat.enemy->getAttack() * (50 - combat.player->Defense) / 100;
-				} else {
-					dmg = combat.enemy->getAttack();
-				}
-				
-				if (dmg < 0) dmg = 0;
-				
-				combat.playerHealth -=dmg;
-				combat.player->health = combat.playerHealth;
-				
-				if (combat.playerHealth <= 0) {
-					combat.state = CombatState::Defeat;
-				} else {
-					combat.state = CombatState::PlayerTurn;
-				}
-			}
-			
-			if (combat.state == CombatState::Victory) {
-				player.addXP(combat.enemy->getXP());
-				player.gold += combat.enemy->getGold();
-				renderer.drawPlayerUI(player.level, player.xp, player.maxHealth, player.health, player.gold, player.xpThresholds);
-				SDL_Delay(500);
-				combat.state = CombatState::PlayerTurn;
-				combat.enemyHealth = combat.enemy->getHealth();
-				combat.lastDamage = 0;
-				combat.playerActed = false;
-				
-				state = GameState::Explore;
-			}
-			
-			if (combat.state == CombatState::Defeat) {
-				player.applyDeathPenalty();
-				state = GameState::Explore;
-			}
+		}
+		
+		if (showProfiler) {
+			if (statsFrame % 30 == 0) profilerLines = profiler().overlayLines(); // Sorting 300 frames per phase, not every frame
+			renderer.drawDebugText(profilerLines, 10, renderer.windowHeight / 4);
 		}
 		
 	    renderer.present();
 		
-		SDL_Delay(16); // ~~ 60 FPS
+		const RenderStats& stats = renderer.getFrameStats();
+		profiler().endFrame({ stats.drawCalls, stats.commands, stats.textureChanges, renderer.getFrameUploads() });
+		
+		if (options.renderStats && (statsFrame + 1) % 60 == 0) {
+			std::cout << "Render: " << stats.commands << " quads, " << stats.drawCalls << " draw calls, "
+			          << stats.textureChanges << " texture changes\n";
+		}
+		statsFrame++;
+		
+		limiter.wait();
 	}
 	
+	chunks.stop();
+	audio.shutdown();
 	renderer.shutdown();
 }
 std::vector<InventorySlotInfo> showInventory(Inventory& inv) { return getInventoryInfo(inv); }
@@ -610,7 +554,7 @@ std::vector<InventorySlotInfo> getInventoryInfo(Inventory& inv) {
 		slot.isEmpty = (item == nullptr);
 		
 		if (item) {
-			slot.name = item->getName();
+			slot.name = std::string(item->getName());
 			slot.stackCount = item->getStackCount();
 			slot.itemID = item->getItemID();
 			
@@ -641,50 +585,39 @@ void explore(Player& player) {
 		// Space for collision checks and encounters
 	}
 }
-void fight(CombatContext* ctx, int playerChoice) {
-    if (ctx->state == CombatState::PlayerTurn) {
-        
-        if (playerChoice == 1) { // Attack
-            int base = ctx->player->getAttackDamage();
-			int damage = base - ctx->enemy->getDefense();
-            if (damage < 0) damage = 0;
-        
-            ctx->enemyHealth -= damage;
-            ctx->lastDamage = damage;
-            ctx->playerActed = true;
-            
-            if (ctx->enemyHealth <= 0) {
-                ctx->state = CombatState::Victory;
-                return;
-            }
-            
-            ctx->state = CombatState::EnemyTurn;
-        }
-        
-        else if (playerChoice == 2) { // Use Potion
-            bool used = ctx->player->consumePotion(ctx->player->findFirstPotionSlot());
-			
-			if (used) {
-				ctx->playerHealth = ctx->player->health;
-				ctx->playerActed = true;
-				ctx->state = CombatState::EnemyTurn;
-			} else {
-				std::cerr << "No potions available!\n";
-				ctx->state = CombatState::PlayerTurn;
-			}
-        }
-    }
-}
-
 // Main Function for execution
-int main() {
+int main(int argc, char** argv) {
 	using namespace std;
 	
+	GameOptions options;
+	bool fpsGiven = false;
+	auto readInt = [&](int& i, int& out) { // Value of "--flag N", left alone when N is missing or not a number
+		if (i + 1 >= argc) return false;
+		const char* text = argv[i + 1];
+		int value = 0;
+		auto [parsed, err] = from_chars(text, text + char_traits<char>::length(text), value);
+		if (err != errc() || *parsed != '\0') return false;
+		out = value;
+		i++;
+		return true;
+	};
+	for (int i = 1; i < argc; ++i) {
+		if (string(argv[i]) == "--watch") options.watchContent = true;
+		else if (string(argv[i]) == "--render-stats") options.renderStats = true;
+		else if (string(argv[i]) == "--vsync") options.vsync = true;
+		else if (string(argv[i]) == "--mute") options.mute = true;
+		else if (string(argv[i]) == "--tick-rate") readInt(i, options.tickRate);
+		else if (string(argv[i]) == "--fps") fpsGiven = readInt(i, options.maxFPS);
+		else if (string(argv[i]) == "--world" && i + 1 < argc) options.worldDir = argv[++i];
+	}
+	if (options.vsync && !fpsGiven) options.maxFPS = 0; // The display paces frames
+	options.tickRate = max(1, options.tickRate);
+	
 	cerr << "Controls:\n";
-	cerr << "'I' opens the inventory\n'ESC' closes the inventory/fights\n'WASD/Arrows' to move\n'E' to equip/consume an item\n";
+	cerr << "'I' opens the inventory\n'ESC' closes the inventory/fights\n'WASD/Arrows' to move\n'E' to equip/consume an item\n'F3' shows frame timings, 'F4' saves them to profile.csv\n";
 	cerr << "Warning VERY BUGGY ATM";
 	
-	runGame();
+	runGame(options);
 	return 0;
 }
 
@@ -0,0 +1,91 @@
+// Includes
+# include "RectPacker.hpp"
+# include <algorithm>
+
+// RectPacker Functions
+RectPacker::RectPacker(int width, int height) : width(width), height(height) {
+    reset();
+}
+void RectPacker::reset() {
+    skyline.clear();
+    skyline.push_back({ 0, 0, width });
+    usedArea = 0;
+}
+int RectPacker::fit(size_t index, int w, int h) const {
+    int x = skyline[index].x;
+    if (x + w > width) return -1;
+
+    // The rectangle rests on the highest node it spans
+    int y = skyline[index].y;
+    int widthLeft = w;
+    for (size_t i = index; widthLeft > 0; ++i) {
+        if (i == skyline.size()) return -1;
+
+        y = std::max(y, skyline[i].y);
+        if (y + h > height) return -1;
+        widthLeft -= skyline[i].width;
+    }
+    return y;
+}
+bool RectPacker::insert(int w, int h, int& x, int& y) {
+    if (w <= 0 || h <= 0) return false;
+
+    // Bottom-left: lowest resulting top edge, ties go to the narrower node so wide gaps stay open
+    int bestTop = height + 1;
+    int bestWidth = width + 1;
+    size_t bestIndex = skyline.size();
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int top = fit(i, w, h);
+        if (top < 0) continue;
+
+        top += h;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth)) {
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestIndex = i;
+            x = skyline[i].x;
+            y = top - h;
+        }
+    }
+
+    if (bestIndex == skyline.size()) return false;
+
+    addLevel(bestIndex, x, y, w, h);
+    usedArea += static_cast<long long>(w) * h;
+    return true;
+}
+void RectPacker::addLevel(size_t index, int x, int y, int w, int h) {
+    skyline.insert(skyline.begin() + index, { x, y + h, w });
+
+    // Cut the nodes the new one now covers
+    for (size_t i = index + 1; i < skyline.size();) {
+        const SkylineNode& prev = skyline[i - 1];
+        int overlap = prev.x + prev.width - skyline[i].x;
+        if (overlap <= 0) break;
+
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0) break;
+
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+int RectPacker::getUsedHeight() const {
+    int top = 0;
+    for (const auto& node : skyline) top = std::max(top, node.y);
+    return top;
+}
+double RectPacker::getOccupancy() const {
+    return static_cast<double>(usedArea) / (static_cast<double>(width) * height);
+}
@@ -0,0 +1,39 @@
+# ifndef RECTPACKER_HPP
+# define RECTPACKER_HPP
+
+# include <cstddef>
+# include <vector>
+
+// Skyline bottom-left rectangle packer, used to lay sprites out on atlas pages. No SDL in here.
+// Insert the biggest rectangles first (sort by height), it wastes a lot less space that way.
+
+// Classes
+class RectPacker {
+    public:
+        RectPacker(int width, int height);
+
+        bool insert(int w, int h, int& x, int& y); // False when there is no room left for it
+        void reset();
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        int getUsedHeight() const; // Highest point of the skyline, a page can be cropped to this
+        double getOccupancy() const; // Packed area / page area
+
+    private:
+        struct SkylineNode {
+            int x;
+            int y;
+            int width;
+        };
+
+        int fit(size_t index, int w, int h) const; // y the rectangle would sit at on this node, -1 if it doesn't fit
+        void addLevel(size_t index, int x, int y, int w, int h);
+
+        int width;
+        int height;
+        long long usedArea = 0;
+        std::vector<SkylineNode> skyline;
+};
+
+# endif
@@ -0,0 +1,105 @@
+// Includes
+# include "RenderQueue.hpp"
+# include <algorithm>
+# include <functional>
+
+// RenderQueue Functions
+void RenderQueue::reset() {
+    commands.clear();
+}
+void RenderQueue::fillRect(RenderLayer layer, const SDL_Rect& dst, SDL_Color color) {
+    commands.push_back({ layer, nullptr, true, { 0, 0, 0, 0 }, dst, color });
+}
+void RenderQueue::copy(RenderLayer layer, SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, SDL_Color color) {
+    if (!texture) return;
+    commands.push_back({ layer, texture, src == nullptr, src ? *src : SDL_Rect{ 0, 0, 0, 0 }, dst, color });
+}
+void RenderQueue::append(const RenderQueue& other) {
+    commands.insert(commands.end(), other.commands.begin(), other.commands.end());
+}
+RenderStats RenderQueue::submit(SDL_Renderer* renderer, int offsetX, int offsetY) {
+    RenderStats stats;
+    stats.commands = static_cast<int>(commands.size());
+
+    // Stable, so same-texture draws in a layer still stack in the order they were recorded
+    std::stable_sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        return std::less<SDL_Texture*>()(a.texture, b.texture);
+    });
+
+    for (size_t first = 0; first < commands.size();) {
+        size_t last = first + 1;
+        while (last < commands.size() && commands[last].texture == commands[first].texture) last++;
+
+        if (first > 0) stats.textureChanges++; // Runs only end where the texture changes
+
+        if (!geometryUnsupported && submitBatch(renderer, first, last, offsetX, offsetY)) {
+            stats.drawCalls++;
+        } else {
+            geometryUnsupported = true;
+            submitEach(renderer, first, last, offsetX, offsetY, stats);
+        }
+        first = last;
+    }
+
+    commands.clear();
+    return stats;
+}
+bool RenderQueue::submitBatch(SDL_Renderer* renderer, size_t first, size_t last, int offsetX, int offsetY) {
+    SDL_Texture* texture = commands[first].texture;
+    float texW = 1.0f;
+    float texH = 1.0f;
+    if (texture) {
+        int w = 0, h = 0;
+        if (SDL_QueryTexture(texture, nullptr, nullptr, &w, &h) != 0 || w <= 0 || h <= 0) return false;
+        texW = static_cast<float>(w);
+        texH = static_cast<float>(h);
+    }
+
+    vertices.clear();
+    indices.clear();
+    for (size_t i = first; i < last; ++i) {
+        const Command& c = commands[i];
+
+        float x0 = static_cast<float>(c.dst.x + offsetX);
+        float y0 = static_cast<float>(c.dst.y + offsetY);
+        float x1 = x0 + c.dst.w;
+        float y1 = y0 + c.dst.h;
+
+        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+        if (!c.wholeTexture) {
+            u0 = c.src.x / texW;
+            v0 = c.src.y / texH;
+            u1 = (c.src.x + c.src.w) / texW;
+            v1 = (c.src.y + c.src.h) / texH;
+        }
+
+        int base = static_cast<int>(vertices.size());
+        vertices.push_back({ { x0, y0 }, c.color, { u0, v0 } });
+        vertices.push_back({ { x1, y0 }, c.color, { u1, v0 } });
+        vertices.push_back({ { x0, y1 }, c.color, { u0, v1 } });
+        vertices.push_back({ { x1, y1 }, c.color, { u1, v1 } });
+
+        int quad[6] = { base, base + 1, base + 2, base + 1, base + 3, base + 2 };
+        indices.insert(indices.end(), quad, quad + 6);
+    }
+
+    return SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                              indices.data(), static_cast<int>(indices.size())) == 0;
+}
+void RenderQueue::submitEach(SDL_Renderer* renderer, size_t first, size_t last, int offsetX, int offsetY, RenderStats& stats) {
+    for (size_t i = first; i < last; ++i) {
+        const Command& c = commands[i];
+        SDL_Rect dst{ c.dst.x + offsetX, c.dst.y + offsetY, c.dst.w, c.dst.h };
+
+        if (!c.texture) {
+            SDL_SetRenderDrawColor(renderer, c.color.r, c.color.g, c.color.b, c.color.a);
+            SDL_RenderFillRect(renderer, &dst);
+        } else {
+            SDL_SetTextureColorMod(c.texture, c.color.r, c.color.g, c.color.b);
+            SDL_SetTextureAlphaMod(c.texture, c.color.a);
+            SDL_RenderCopy(renderer, c.texture, c.wholeTexture ? nullptr : &c.src, &dst);
+        }
+        stats.drawCalls++;
+    }
+}
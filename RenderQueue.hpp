@@ -0,0 +1,61 @@
+# ifndef RENDERQUEUE_HPP
+# define RENDERQUEUE_HPP
+
+# include <vector>
+# include <SDL2/SDL.h>
+
+// A frame's worth of textured and solid quads, recorded instead of drawn.
+// submit() orders them by layer then texture and sends each run of one texture as a single SDL_RenderGeometry call.
+// Inside a layer only draws that share a texture keep their order, so anything that must stack goes in a higher layer.
+
+// Structures
+enum class RenderLayer : unsigned char {
+    Backdrop,
+    World,       // NPCs
+    Actors,      // Player, over NPCs
+    Panels,      // Inventory slots, HUD boxes and bars
+    Icons,       // Items in slots
+    Text,
+    Tooltips,
+    TooltipText,
+    Debug,       // Profiler overlay, over everything
+    DebugText
+};
+
+struct RenderStats {
+    int commands = 0;       // Quads recorded, what drawing each one on its own would cost in draw calls
+    int drawCalls = 0;      // Calls actually made into SDL
+    int textureChanges = 0; // Times the bound texture switched between calls
+};
+
+// Classes
+class RenderQueue {
+    public:
+        void reset();
+        void fillRect(RenderLayer layer, const SDL_Rect& dst, SDL_Color color);
+        void copy(RenderLayer layer, SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, SDL_Color color = { 255, 255, 255, 255 });
+        void append(const RenderQueue& other);
+
+        RenderStats submit(SDL_Renderer* renderer, int offsetX = 0, int offsetY = 0); // Draws everything moved by the offset, and resets
+        size_t size() const { return commands.size(); }
+
+    private:
+        struct Command {
+            RenderLayer layer;
+            SDL_Texture* texture; // nullptr for solid fills
+            bool wholeTexture;
+            SDL_Rect src;
+            SDL_Rect dst;
+            SDL_Color color;
+        };
+
+        bool submitBatch(SDL_Renderer* renderer, size_t first, size_t last, int offsetX, int offsetY);
+        void submitEach(SDL_Renderer* renderer, size_t first, size_t last, int offsetX, int offsetY, RenderStats& stats);
+
+        std::vector<Command> commands;
+        std::vector<SDL_Vertex> vertices; // Scratch, kept between frames
+        std::vector<int> indices;
+        bool geometryUnsupported = false; // Set when the backend rejects SDL_RenderGeometry, then it is one call per quad
+};
+
+# endif
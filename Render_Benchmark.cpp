@@ -0,0 +1,213 @@
+// Headless render benchmark and golden-image check, draws into an offscreen surface so no window or display is needed
+// Usage: renderbench [--frames N] [--size WxH] [--golden DIR] [--update 0|1] [--tolerance N]
+// Times full explore and inventory frames, with the retained panels and tooltip cache warm and then rebuilt every frame.
+// With --golden, drawInventory, drawPlayerUI and drawTooltip are each drawn alone and compared with DIR/<name>.png:
+// missing goldens are written, --update 1 rewrites them all, differences go to DIR/<name>-diff.png and exit with 1
+
+// Includes
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <algorithm>
+# include <filesystem>
+# include "render2d.hpp"
+# include "ImageDiff.hpp"
+# include "RPG_Inventory_System.hpp"
+# include "Player.hpp"
+
+// Structures
+struct BenchConfig {
+    int frames = 500;
+    int width = 1280;
+    int height = 720;
+    std::string goldenDir; // Empty skips the image checks
+    bool update = false;
+    int tolerance = 0; // Per channel, software rendering is exact on one build but not across SDL versions
+};
+struct Scene { // What the game would have on screen, fixed so every run draws the same frame
+    Player player;
+    InventoryLayout layout;
+    const Item* hovered = nullptr;
+};
+
+// Functions
+static bool parseArgs(int argc, char** argv, BenchConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--frames") cfg.frames = std::stoi(value);
+        else if (arg == "--golden") cfg.goldenDir = value;
+        else if (arg == "--update") cfg.update = value != "0";
+        else if (arg == "--tolerance") cfg.tolerance = std::stoi(value);
+        else if (arg == "--size") {
+            auto x = value.find('x');
+            if (x == std::string::npos) {
+                std::cerr << "--size wants WxH\n";
+                return false;
+            }
+            cfg.width = std::stoi(value.substr(0, x));
+            cfg.height = std::stoi(value.substr(x + 1));
+        }
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    cfg.frames = std::max(1, cfg.frames);
+    cfg.width = std::max(64, cfg.width);
+    cfg.height = std::max(64, cfg.height);
+    return true;
+}
+static void buildScene(Renderer& renderer, Scene& scene, std::vector<ItemPtr>& items) {
+    for (auto& item : items) {
+        if (item) scene.player.inventory.addItem(std::move(item));
+    }
+    scene.player.level = 3;
+    scene.player.xp = 70;
+    scene.player.health = 64;
+    scene.player.gold = 125;
+
+    const Inventory& inventory = scene.player.inventory;
+    int cols = 10;
+    int rows = (inventory.getGeneralSlotCount() + cols - 1) / cols;
+    scene.layout = renderer.inventoryLayout(cols, rows, inventory.getArmorSlotCount());
+    scene.hovered = inventory.getItem(0);
+}
+static void drawHUD(Renderer& renderer, Scene& scene) {
+    Player& p = scene.player;
+    renderer.drawPlayerUI(p.level, p.xp, p.maxHealth, p.health, p.gold, p.xpThresholds);
+}
+static void drawTooltip(Renderer& renderer, Scene& scene) {
+    if (!scene.hovered) return;
+    SDL_Rect slot = scene.layout.generalSlot(0);
+    renderer.drawTooltip(scene.hovered->getItemID(), scene.hovered->getName(), scene.hovered->getDescription(), slot.x + 16, slot.y + 16);
+}
+static void drawExploreFrame(Renderer& renderer, Scene& scene) { // Same order as runGame
+    renderer.clear();
+    renderer.drawBackdrop();
+    drawHUD(renderer, scene);
+    renderer.drawNPC(200, 200, 4);
+    renderer.drawNPC(300, 200, 3);
+    renderer.drawNPC(400, 200, 2);
+    renderer.drawNPC(600, 400, 1);
+    renderer.drawPlayer(0, renderer.windowHeight - 100);
+    renderer.present();
+}
+static void drawInventoryFrame(Renderer& renderer, Scene& scene) {
+    renderer.clear();
+    renderer.drawBackdrop();
+    renderer.drawInventory(scene.player.inventory, scene.layout);
+    drawTooltip(renderer, scene);
+    drawHUD(renderer, scene);
+    renderer.present();
+}
+template <typename Fn>
+static void benchmark(const char* label, Renderer& renderer, int frames, bool cold, Fn&& drawFrame) {
+    drawFrame(); // Warm up: atlases touched, panels and tooltip composed
+
+    std::vector<double> times;
+    times.reserve(frames);
+    long long drawCalls = 0, quads = 0;
+    double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+    for (int i = 0; i < frames; ++i) {
+        if (cold) renderer.invalidateRenderTargets(); // Forces every panel and tooltip to be drawn again
+        Uint64 start = SDL_GetPerformanceCounter();
+        drawFrame();
+        times.push_back((SDL_GetPerformanceCounter() - start) * 1000.0 / frequency);
+
+        const RenderStats& stats = renderer.getFrameStats();
+        drawCalls += stats.drawCalls;
+        quads += stats.commands;
+    }
+
+    std::sort(times.begin(), times.end());
+    double total = 0.0;
+    for (double t : times) total += t;
+
+    std::cout << std::left << std::setw(18) << label << std::right << std::fixed << std::setprecision(3)
+              << " min " << std::setw(7) << times.front()
+              << "  avg " << std::setw(7) << total / frames
+              << "  p99 " << std::setw(7) << times[std::min(times.size() - 1, times.size() * 99 / 100)] << " ms"
+              << "  (" << drawCalls / frames << " draw calls, " << quads / frames << " quads per frame)\n";
+}
+template <typename Fn>
+static bool checkGolden(const BenchConfig& cfg, Renderer& renderer, const std::string& name, Fn&& draw) {
+    // Drawn alone on black and from scratch, so the image only changes when that function's output does
+    renderer.invalidateRenderTargets();
+    renderer.clear();
+    draw();
+    renderer.present();
+    SDL_Surface* frame = renderer.getFrameSurface();
+
+    std::string path = cfg.goldenDir + "/" + name + ".png";
+    SDL_Surface* golden = cfg.update ? nullptr : loadImage(path);
+    if (!golden) {
+        bool saved = saveImage(frame, path);
+        std::cout << std::left << std::setw(18) << name << (saved ? " written " : " FAILED to write ") << path << "\n";
+        return saved;
+    }
+
+    ImageDiff diff = diffImages(frame, golden, cfg.tolerance);
+    bool ok = diff.matches();
+    std::cout << std::left << std::setw(18) << name;
+    if (ok) {
+        std::cout << " ok (max channel delta " << diff.maxDelta << ")\n";
+    } else if (!diff.sizeMatches) {
+        std::cout << " FAILED, golden is not " << cfg.width << "x" << cfg.height << "\n";
+    } else {
+        std::string diffPath = cfg.goldenDir + "/" + name + "-diff.png";
+        SDL_Surface* image = makeDiffImage(frame, golden, cfg.tolerance);
+        saveImage(image, diffPath);
+        SDL_FreeSurface(image);
+        std::cout << " FAILED, " << diff.differentPixels << " pixels differ (max delta " << diff.maxDelta << ") in "
+                  << diff.bounds.w << "x" << diff.bounds.h << " at " << diff.bounds.x << "," << diff.bounds.y
+                  << ", see " << diffPath << "\n";
+    }
+
+    SDL_FreeSurface(golden);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    if (!parseArgs(argc, argv, cfg)) return 1;
+
+    Renderer renderer;
+    if (!renderer.initHeadless(cfg.width, cfg.height)) return 1;
+
+    ItemFactory itemfactory;
+    std::vector<ItemPtr> items = itemfactory.loadItems("ItemList.txt");
+    Scene scene;
+    buildScene(renderer, scene, items);
+
+    std::cout << "=== " << cfg.width << "x" << cfg.height << ", " << cfg.frames << " frames ===\n";
+    benchmark("explore", renderer, cfg.frames, false, [&] { drawExploreFrame(renderer, scene); });
+    benchmark("explore cold", renderer, cfg.frames, true, [&] { drawExploreFrame(renderer, scene); });
+    benchmark("inventory", renderer, cfg.frames, false, [&] { drawInventoryFrame(renderer, scene); });
+    benchmark("inventory cold", renderer, cfg.frames, true, [&] { drawInventoryFrame(renderer, scene); });
+
+    bool passed = true;
+    if (!cfg.goldenDir.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(cfg.goldenDir, error);
+
+        std::cout << "\n=== Golden images in " << cfg.goldenDir << " ===\n";
+        passed &= checkGolden(cfg, renderer, "inventory", [&] { renderer.drawInventory(scene.player.inventory, scene.layout); });
+        passed &= checkGolden(cfg, renderer, "playerui", [&] { drawHUD(renderer, scene); });
+        passed &= checkGolden(cfg, renderer, "tooltip", [&] { drawTooltip(renderer, scene); });
+    }
+
+    renderer.shutdown();
+    return passed ? 0 : 1;
+}
+
+// Build with:
+// g++ -O2 Render_Benchmark.cpp render2d.cpp ImageDiff.cpp TextureAtlas.cpp RectPacker.cpp GlyphAtlas.cpp TooltipCache.cpp AssetStreamer.cpp RenderQueue.cpp Profiler.cpp RPG_Inventory_System.cpp NPCs.cpp GameData.cpp TextParser.cpp -pthread -lSDL2 -lSDL2_image -lSDL2_ttf -o renderbench
@@ -0,0 +1,131 @@
+// Includes
+# include "SpatialHash.hpp"
+# include <algorithm>
+# ifdef __SSE2__ // Always there on x86-64 GCC and Clang
+# include <emmintrin.h>
+# define SPATIALHASH_SSE2 1
+# endif
+
+// SpatialHash Functions
+SpatialHash::SpatialHash(int cellSize) : cellSize(std::max(1, cellSize)) {}
+int SpatialHash::toCell(int v) const {
+    return v >= 0 ? v / cellSize : -((-v + cellSize - 1) / cellSize);
+}
+SpatialHash::CellRange SpatialHash::rangeOf(int x, int y, int w, int h) const {
+    // A box covers x .. x + w - 1, zero sized boxes still sit in one cell
+    return { toCell(x), toCell(y), toCell(x + std::max(1, w) - 1), toCell(y + std::max(1, h) - 1), true };
+}
+void SpatialHash::addToCells(int id, const CellRange& range) {
+    for (int cy = range.minY; cy <= range.maxY; ++cy) {
+        for (int cx = range.minX; cx <= range.maxX; ++cx) cells[cellKey(cx, cy)].push_back(id);
+    }
+}
+void SpatialHash::removeFromCells(int id, const CellRange& range) {
+    for (int cy = range.minY; cy <= range.maxY; ++cy) {
+        for (int cx = range.minX; cx <= range.maxX; ++cx) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+
+            // Order inside a cell doesn't matter, swap the last one in. Empty cells are kept, their capacity gets reused
+            std::vector<int>& list = it->second;
+            auto found = std::find(list.begin(), list.end(), id);
+            if (found == list.end()) continue;
+            *found = list.back();
+            list.pop_back();
+        }
+    }
+}
+void SpatialHash::insert(int id, int x, int y, int w, int h) {
+    if (id < 0) return;
+    if (static_cast<size_t>(id) >= ranges.size()) {
+        ranges.resize(id + 1, CellRange{ 0, 0, 0, 0, false });
+        seen.resize(id + 1, 0);
+    }
+    if (ranges[id].used) removeFromCells(id, ranges[id]);
+
+    ranges[id] = rangeOf(x, y, w, h);
+    addToCells(id, ranges[id]);
+}
+void SpatialHash::update(int id, int x, int y, int w, int h) {
+    if (id < 0 || static_cast<size_t>(id) >= ranges.size() || !ranges[id].used) {
+        insert(id, x, y, w, h);
+        return;
+    }
+
+    CellRange next = rangeOf(x, y, w, h);
+    const CellRange& current = ranges[id];
+    if (next.minX == current.minX && next.minY == current.minY && next.maxX == current.maxX && next.maxY == current.maxY) return;
+
+    removeFromCells(id, current);
+    ranges[id] = next;
+    addToCells(id, next);
+}
+void SpatialHash::remove(int id) {
+    if (id < 0 || static_cast<size_t>(id) >= ranges.size() || !ranges[id].used) return;
+    removeFromCells(id, ranges[id]);
+    ranges[id].used = false;
+}
+void SpatialHash::clear() {
+    cells.clear();
+    ranges.clear();
+    seen.clear();
+    queryStamp = 0;
+}
+void SpatialHash::queryBox(int x, int y, int w, int h, std::vector<int>& out) const {
+    out.clear();
+    if (++queryStamp == 0) { // Wrapped, old stamps could look current
+        std::fill(seen.begin(), seen.end(), 0);
+        queryStamp = 1;
+    }
+
+    CellRange range = rangeOf(x, y, w, h);
+    for (int cy = range.minY; cy <= range.maxY; ++cy) {
+        for (int cx = range.minX; cx <= range.maxX; ++cx) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+
+            for (int id : it->second) {
+                if (seen[id] == queryStamp) continue; // Spans several cells, already listed
+                seen[id] = queryStamp;
+                out.push_back(id);
+            }
+        }
+    }
+}
+void SpatialHash::queryRadius(int cx, int cy, int radius, std::vector<int>& out) const {
+    radius = std::max(0, radius);
+    queryBox(cx - radius, cy - radius, radius * 2 + 1, radius * 2 + 1, out);
+}
+
+// General Functions
+void overlapBoxes(const int* x, const int* y, const int* w, const int* h, int count,
+                  int boxX, int boxY, int boxW, int boxH, std::vector<int>& hits) {
+    int i = 0;
+# ifdef SPATIALHASH_SSE2
+    // x[i] < boxRight && boxX < x[i] + w[i], and the same for y
+    const __m128i left = _mm_set1_epi32(boxX);
+    const __m128i top = _mm_set1_epi32(boxY);
+    const __m128i right = _mm_set1_epi32(boxX + boxW);
+    const __m128i bottom = _mm_set1_epi32(boxY + boxH);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i bx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        __m128i by = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+        __m128i bw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+        __m128i bh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+
+        __m128i inX = _mm_and_si128(_mm_cmplt_epi32(bx, right), _mm_cmpgt_epi32(_mm_add_epi32(bx, bw), left));
+        __m128i inY = _mm_and_si128(_mm_cmplt_epi32(by, bottom), _mm_cmpgt_epi32(_mm_add_epi32(by, bh), top));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(inX, inY)));
+
+        while (mask) { // One bit per lane that overlapped
+            int lane = __builtin_ctz(static_cast<unsigned>(mask));
+            hits.push_back(i + lane);
+            mask &= mask - 1;
+        }
+    }
+# endif
+    for (; i < count; ++i) {
+        if (x[i] < boxX + boxW && boxX < x[i] + w[i] && y[i] < boxY + boxH && boxY < y[i] + h[i]) hits.push_back(i);
+    }
+}
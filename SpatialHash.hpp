@@ -0,0 +1,64 @@
+# ifndef SPATIALHASH_HPP
+# define SPATIALHASH_HPP
+
+# include <cstddef>
+# include <cstdint>
+# include <vector>
+# include <unordered_map>
+
+// Uniform grid broadphase. Every id is listed in each cell its box touches; a query returns everything listed in
+// the cells it touches, so the result is candidates, not hits. Run them through overlapBoxes (or an exact test of
+// your own) afterwards. Cells live in a hash map, so the world can be any size and empty space costs nothing.
+// No SDL in here.
+
+// Classes
+class SpatialHash {
+    public:
+        explicit SpatialHash(int cellSize = 64); // About twice the usual box size works well
+
+        void insert(int id, int x, int y, int w, int h); // ids are small non-negative ints, like array indices
+        void update(int id, int x, int y, int w, int h); // Nothing to do unless the box crossed into other cells
+        void remove(int id);
+        void clear();
+
+        // Each candidate once, in no particular order; out is cleared first. Not safe to call from two threads at once
+        void queryBox(int x, int y, int w, int h, std::vector<int>& out) const;
+        void queryRadius(int cx, int cy, int radius, std::vector<int>& out) const; // Cells touching the circle's bounding box
+
+        int getCellSize() const { return cellSize; }
+        size_t getCellCount() const { return cells.size(); } // Cells with something in them
+
+    private:
+        struct CellRange {
+            int minX, minY, maxX, maxY; // Inclusive, in cells
+            bool used;
+        };
+        struct CellKeyHash {
+            size_t operator()(uint64_t key) const { // Cell coordinates are small and regular, mix them before bucketing
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return static_cast<size_t>(key);
+            }
+        };
+
+        static uint64_t cellKey(int cx, int cy) { return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy); }
+        int toCell(int v) const; // Floor division, so negative coordinates work
+        CellRange rangeOf(int x, int y, int w, int h) const;
+        void addToCells(int id, const CellRange& range);
+        void removeFromCells(int id, const CellRange& range);
+
+        int cellSize;
+        std::unordered_map<uint64_t, std::vector<int>, CellKeyHash> cells;
+        std::vector<CellRange> ranges; // Indexed by id
+        mutable std::vector<unsigned> seen; // Indexed by id, == queryStamp when already returned by this query
+        mutable unsigned queryStamp = 0;
+};
+
+// Functions
+// Appends to hits the positions i in [0, count) whose box (x[i], y[i], w[i], h[i]) overlaps the query box, edges
+// touching don't count. Four boxes per step with SSE2 where the compiler has it, one at a time otherwise
+void overlapBoxes(const int* x, const int* y, const int* w, const int* h, int count,
+                  int boxX, int boxY, int boxW, int boxH, std::vector<int>& hits);
+
+# endif
@@ -0,0 +1,40 @@
+# ifndef SPSCQUEUE_HPP
+# define SPSCQUEUE_HPP
+
+# include <array>
+# include <atomic>
+# include <cstddef>
+
+// Fixed size single producer, single consumer ring. push() from one thread and pop() from one other thread,
+// neither ever blocks or allocates, so it is safe to read from an audio callback.
+
+// Classes
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        bool push(const T& value) { // Producer only, false when full
+            size_t tail = writeIndex.load(std::memory_order_relaxed);
+            if (tail - readIndex.load(std::memory_order_acquire) == Capacity) return false;
+
+            slots[tail & (Capacity - 1)] = value;
+            writeIndex.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        bool pop(T& value) { // Consumer only, false when empty
+            size_t head = readIndex.load(std::memory_order_relaxed);
+            if (head == writeIndex.load(std::memory_order_acquire)) return false;
+
+            value = slots[head & (Capacity - 1)];
+            readIndex.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<T, Capacity> slots{};
+        alignas(64) std::atomic<size_t> writeIndex{ 0 }; // Own cache lines, the two threads write one each
+        alignas(64) std::atomic<size_t> readIndex{ 0 };
+};
+
+# endif
@@ -0,0 +1,99 @@
+// Includes
+# include "TextParser.hpp"
+# include <iostream>
+# include <fstream>
+# include <cstring>
+# include <charconv>
+
+// TextScanner Functions
+TextScanner::TextScanner(std::string_view buffer) : buffer(buffer) {}
+bool TextScanner::nextLine(TextLine& line) {
+    if (pos >= buffer.size()) return false;
+
+    const char* start = buffer.data() + pos;
+    size_t remaining = buffer.size() - pos;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', remaining));
+    size_t length = newline ? static_cast<size_t>(newline - start) : remaining;
+
+    pos += newline ? length + 1 : length;
+    if (length > 0 && start[length - 1] == '\r') length--;
+
+    line.text = std::string_view(start, length);
+    line.number = ++lineNumber;
+    return true;
+}
+bool TextScanner::nextBlock(std::string_view separator, std::vector<TextLine>& lines) {
+    lines.clear();
+
+    TextLine line;
+    while (nextLine(line)) {
+        if (line.text.find(separator) != std::string_view::npos) {
+            if (!lines.empty()) return true;
+        } else if (!line.text.empty()) {
+            lines.push_back(line);
+        }
+    }
+
+    // Last block
+    return !lines.empty();
+}
+
+// General Functions
+bool readTextFile(const std::string& filename, std::string& buffer) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+size_t countBlocks(std::string_view buffer, std::string_view separator) {
+    size_t count = 1;
+    for (size_t at = buffer.find(separator); at != std::string_view::npos; at = buffer.find(separator, at + separator.size())) {
+        count++;
+    }
+    return count;
+}
+std::string_view trimLeftView(std::string_view s, std::string_view chars) {
+    size_t start = s.find_first_not_of(chars);
+    return s.substr(start == std::string_view::npos ? s.size() : start); // Empty views stay in place for columnOf
+}
+std::string_view trimView(std::string_view s, std::string_view chars) {
+    s = trimLeftView(s, chars);
+    return s.substr(0, s.find_last_not_of(chars) + 1);
+}
+int columnOf(const TextLine& line, std::string_view part) {
+    return static_cast<int>(part.data() - line.text.data()) + 1;
+}
+bool parseInt(const TextLine& line, std::string_view text, int& out, std::vector<ParseDiagnostic>& diagnostics) {
+    text = trimView(text);
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (first != last && *first == '+') first++; // from_chars only takes '-'
+
+    int value = 0;
+    auto [end, ec] = std::from_chars(first, last, value);
+
+    if (ec == std::errc::result_out_of_range) {
+        diagnostics.push_back({ line.number, columnOf(line, text), "number out of range: '" + std::string(text) + "'" });
+        return false;
+    }
+    if (ec != std::errc()) {
+        diagnostics.push_back({ line.number, columnOf(line, text), "expected a number, got '" + std::string(text) + "'" });
+        return false;
+    }
+    if (end != last) { // std::stoi quietly took the leading number, keep doing that but say so
+        std::string_view rest(end, static_cast<size_t>(last - end));
+        diagnostics.push_back({ line.number, columnOf(line, rest), "ignoring '" + std::string(rest) + "' after the number" });
+    }
+
+    out = value;
+    return true;
+}
+void reportDiagnostics(const std::string& filename, const std::vector<ParseDiagnostic>& diagnostics) {
+    for (const auto& d : diagnostics) {
+        std::cerr << filename << ":" << d.line << ":" << d.column << ": " << d.message << "\n";
+    }
+}
@@ -0,0 +1,48 @@
+# ifndef TEXTPARSER_HPP
+# define TEXTPARSER_HPP
+
+# include <string>
+# include <string_view>
+# include <vector>
+
+// Single pass tokenizer for the block based text formats (ItemList.txt, NPCs.txt)
+// Lines and fields are views into the file buffer, nothing is copied until a definition keeps it
+
+// Structures
+struct ParseDiagnostic {
+    int line; // 1 based
+    int column; // 1 based
+    std::string message;
+};
+struct TextLine {
+    std::string_view text; // Without the line ending, CRLF files lose the '\r' too
+    int number; // 1 based
+};
+
+// Classes
+class TextScanner {
+    public:
+        explicit TextScanner(std::string_view buffer);
+
+        // Fills lines with the non-empty lines before the next line containing separator, false once the buffer is used up
+        bool nextBlock(std::string_view separator, std::vector<TextLine>& lines);
+
+    private:
+        bool nextLine(TextLine& line);
+
+        std::string_view buffer;
+        size_t pos = 0;
+        int lineNumber = 0;
+};
+
+// Functions
+bool readTextFile(const std::string& filename, std::string& buffer);
+size_t countBlocks(std::string_view buffer, std::string_view separator); // Cheap upper bound for reserving ahead of a parse
+std::string_view trimLeftView(std::string_view s, std::string_view chars = " \t");
+std::string_view trimView(std::string_view s, std::string_view chars = " \t");
+int columnOf(const TextLine& line, std::string_view part); // part must point into line.text
+// Reads a decimal int the way std::stoi did, but reports bad input instead of throwing; out is untouched on failure
+bool parseInt(const TextLine& line, std::string_view text, int& out, std::vector<ParseDiagnostic>& diagnostics);
+void reportDiagnostics(const std::string& filename, const std::vector<ParseDiagnostic>& diagnostics);
+
+# endif
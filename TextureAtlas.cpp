@@ -0,0 +1,160 @@
+// Includes
+# include "TextureAtlas.hpp"
+# include "RectPacker.hpp"
+# include <iostream>
+# include <algorithm>
+# include <filesystem>
+# include <charconv>
+# include <SDL2/SDL_image.h>
+
+// Structures
+struct AtlasPlacement {
+    size_t image; // Index into the loaded surfaces
+    int page;
+    int x;
+    int y;
+};
+
+// General Functions
+static const int AtlasPadding = 2; // Transparent gap so filtered sprites never pick up their neighbours
+
+long long atlasKey(int group, int id) {
+    return (static_cast<long long>(group) << 32) | static_cast<unsigned int>(id);
+}
+std::vector<AtlasImage> findAtlasImages(const std::string& directory, const std::string& prefix, int group) {
+    std::vector<AtlasImage> images;
+    std::error_code ec;
+
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (name.size() <= prefix.size() + 4 || name.compare(0, prefix.size(), prefix) != 0) continue;
+        if (name.compare(name.size() - 4, 4, ".png") != 0) continue;
+
+        int id = 0;
+        const char* first = name.data() + prefix.size();
+        const char* last = name.data() + name.size() - 4;
+        auto [parsed, err] = std::from_chars(first, last, id);
+        if (err != std::errc() || parsed != last) continue;
+
+        images.push_back({ atlasKey(group, id), it->path().string() });
+    }
+
+    std::sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b) { return a.key < b.key; });
+    return images;
+}
+static std::vector<AtlasPlacement> layoutPages(const std::vector<SDL_Surface*>& surfaces, const std::vector<size_t>& order,
+                                               int pageSize, bool singlePage, std::vector<RectPacker>& packers) {
+    std::vector<AtlasPlacement> placements;
+    packers.clear();
+
+    for (size_t index : order) {
+        int w = surfaces[index]->w + AtlasPadding;
+        int h = surfaces[index]->h + AtlasPadding;
+        if (w > pageSize || h > pageSize) continue; // Too big for any page, drawn from its own texture instead
+
+        AtlasPlacement p{ index, -1, 0, 0 };
+        for (size_t i = 0; i < packers.size() && p.page < 0; ++i) {
+            if (packers[i].insert(w, h, p.x, p.y)) p.page = static_cast<int>(i);
+        }
+        if (p.page < 0) {
+            if (singlePage && !packers.empty()) return {};
+
+            packers.emplace_back(pageSize, pageSize);
+            packers.back().insert(w, h, p.x, p.y);
+            p.page = static_cast<int>(packers.size() - 1);
+        }
+        placements.push_back(p);
+    }
+
+    return placements;
+}
+
+// TextureAtlas Functions
+TextureAtlas::~TextureAtlas() { destroy(); }
+void TextureAtlas::destroy() {
+    for (SDL_Texture* page : pages) SDL_DestroyTexture(page);
+    pages.clear();
+    sprites.clear();
+}
+const AtlasSprite* TextureAtlas::find(long long key) const {
+    auto it = sprites.find(key);
+    return it == sprites.end() ? nullptr : &it->second;
+}
+bool TextureAtlas::build(SDL_Renderer* renderer, const std::vector<AtlasImage>& images, int maxPageSize) {
+    destroy();
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        if (info.max_texture_width > 0) maxPageSize = std::min(maxPageSize, info.max_texture_width);
+        if (info.max_texture_height > 0) maxPageSize = std::min(maxPageSize, info.max_texture_height);
+    }
+
+    // Load
+    std::vector<SDL_Surface*> surfaces;
+    std::vector<long long> keys;
+    for (const auto& image : images) {
+        SDL_Surface* loaded = IMG_Load(image.path.c_str());
+        if (!loaded) {
+            std::cerr << "Failed to load texture: " << image.path << " | Error: " << IMG_GetError() << "\n";
+            continue;
+        }
+
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(loaded);
+        if (!converted) continue;
+
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE); // Copy alpha as is
+        surfaces.push_back(converted);
+        keys.push_back(image.key);
+    }
+
+    // Layout, tallest first
+    std::vector<size_t> order(surfaces.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (surfaces[a]->h != surfaces[b]->h) return surfaces[a]->h > surfaces[b]->h;
+        return surfaces[a]->w > surfaces[b]->w;
+    });
+
+    std::vector<RectPacker> packers;
+    std::vector<AtlasPlacement> placements;
+    for (int size = 256; size < maxPageSize && placements.empty(); size *= 2) {
+        placements = layoutPages(surfaces, order, size, true, packers);
+        if (!placements.empty() && placements.size() != order.size()) placements.clear(); // Something was too big for this size
+    }
+    if (placements.empty()) placements = layoutPages(surfaces, order, maxPageSize, false, packers);
+
+    // Blit onto page surfaces, cropped to what the skyline actually used
+    std::vector<SDL_Surface*> pageSurfaces;
+    for (const auto& packer : packers) {
+        SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, packer.getWidth(), std::max(1, packer.getUsedHeight()), 32, SDL_PIXELFORMAT_ARGB8888);
+        pageSurfaces.push_back(page);
+    }
+    for (const auto& p : placements) {
+        SDL_Surface* page = pageSurfaces[p.page];
+        if (!page) continue;
+
+        SDL_Rect dst{ p.x, p.y, surfaces[p.image]->w, surfaces[p.image]->h };
+        SDL_BlitSurface(surfaces[p.image], nullptr, page, &dst);
+    }
+
+    for (SDL_Surface* page : pageSurfaces) {
+        SDL_Texture* tex = page ? SDL_CreateTextureFromSurface(renderer, page) : nullptr;
+        if (tex) SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        else std::cerr << "Failed to create atlas page: " << SDL_GetError() << "\n";
+        pages.push_back(tex);
+        SDL_FreeSurface(page);
+    }
+
+    for (const auto& p : placements) {
+        if (!pages[p.page]) continue;
+
+        AtlasSprite sprite;
+        sprite.texture = pages[p.page];
+        sprite.src = { p.x, p.y, surfaces[p.image]->w, surfaces[p.image]->h };
+        sprites[keys[p.image]] = sprite;
+    }
+
+    for (SDL_Surface* s : surfaces) SDL_FreeSurface(s);
+    return !sprites.empty() || images.empty();
+}
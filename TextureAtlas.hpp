@@ -0,0 +1,48 @@
+# ifndef TEXTUREATLAS_HPP
+# define TEXTUREATLAS_HPP
+
+# include <string>
+# include <vector>
+# include <unordered_map>
+# include <SDL2/SDL.h>
+
+// Packs many small images into a few big textures so sprites drawn back to back share one texture.
+// Built once at startup. Pages are as small as they can be: the smallest power of two square that holds everything,
+// or several maxPageSize pages when that isn't enough.
+
+// Structures
+struct AtlasImage {
+    long long key;
+    std::string path;
+};
+struct AtlasSprite {
+    SDL_Texture* texture = nullptr; // The page texture
+    SDL_Rect src{ 0, 0, 0, 0 }; // Where the image sits on it
+};
+
+// Classes
+class TextureAtlas {
+    public:
+        TextureAtlas() = default;
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+        ~TextureAtlas();
+
+        // Images that fail to load or are bigger than a page are left out, find() returns nullptr for them
+        bool build(SDL_Renderer* renderer, const std::vector<AtlasImage>& images, int maxPageSize = 2048);
+        void destroy();
+
+        const AtlasSprite* find(long long key) const;
+        int getPageCount() const { return static_cast<int>(pages.size()); }
+        int getSpriteCount() const { return static_cast<int>(sprites.size()); }
+
+    private:
+        std::vector<SDL_Texture*> pages;
+        std::unordered_map<long long, AtlasSprite> sprites;
+};
+
+// Functions
+std::vector<AtlasImage> findAtlasImages(const std::string& directory, const std::string& prefix, int group); // prefix<ID>.png
+long long atlasKey(int group, int id);
+
+# endif
@@ -0,0 +1,45 @@
+// Includes
+# include "TooltipCache.hpp"
+
+// General Functions
+long long tooltipKey(int itemID, int fontSize) {
+    return (static_cast<long long>(fontSize) << 32) | static_cast<unsigned int>(itemID);
+}
+
+// TooltipCache Functions
+TooltipCache::TooltipCache(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+TooltipCache::~TooltipCache() { clear(); }
+const CachedTooltip* TooltipCache::find(long long key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, it->second); // Iterators stay valid, only the order changes
+    return &it->second->tooltip;
+}
+const CachedTooltip* TooltipCache::insert(long long key, const CachedTooltip& tooltip) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        SDL_DestroyTexture(it->second->tooltip.texture);
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    while (index.size() >= capacity) {
+        SDL_DestroyTexture(entries.back().tooltip.texture);
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+
+    entries.push_front({ key, tooltip });
+    index[key] = entries.begin();
+    return &entries.front().tooltip;
+}
+void TooltipCache::clear() {
+    for (auto& e : entries) SDL_DestroyTexture(e.tooltip.texture);
+    entries.clear();
+    index.clear();
+}
@@ -0,0 +1,50 @@
+# ifndef TOOLTIPCACHE_HPP
+# define TOOLTIPCACHE_HPP
+
+# include <list>
+# include <unordered_map>
+# include <SDL2/SDL.h>
+
+// Bounded LRU of finished tooltip textures (render targets), owned by the cache.
+// Keys are tooltipKey(ItemID, font size); item text only changes on a content reload, which should clear() it.
+
+// Structures
+struct CachedTooltip {
+    SDL_Texture* texture = nullptr;
+    int w = 0;
+    int h = 0;
+};
+
+// Classes
+class TooltipCache {
+    public:
+        explicit TooltipCache(size_t capacity = 64);
+        TooltipCache(const TooltipCache&) = delete;
+        TooltipCache& operator=(const TooltipCache&) = delete;
+        ~TooltipCache();
+
+        const CachedTooltip* find(long long key); // Counts as a use
+        const CachedTooltip* insert(long long key, const CachedTooltip& tooltip); // Takes the texture, evicts the oldest when full
+        void clear();
+
+        size_t size() const { return index.size(); }
+        long long getHits() const { return hits; }
+        long long getMisses() const { return misses; }
+
+    private:
+        struct Entry {
+            long long key;
+            CachedTooltip tooltip;
+        };
+
+        size_t capacity;
+        std::list<Entry> entries; // Most recently used first
+        std::unordered_map<long long, std::list<Entry>::iterator> index;
+        long long hits = 0;
+        long long misses = 0;
+};
+
+// Functions
+long long tooltipKey(int itemID, int fontSize);
+
+# endif
@@ -0,0 +1,152 @@
+// Includes
+# include "WorldEntities.hpp"
+# include <algorithm>
+
+// WorldEntities Functions
+int WorldEntities::add(int archetype, int x, int y, int w, int h, int chunk) {
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->w.push_back(w);
+    this->h.push_back(h);
+    this->archetype.push_back(archetype);
+    state.push_back(EntityState::Idle);
+    this->chunk.push_back(chunk);
+    grid.insert(size() - 1, x, y, w, h);
+    return size() - 1;
+}
+void WorldEntities::clear() {
+    x.clear();
+    y.clear();
+    w.clear();
+    h.clear();
+    archetype.clear();
+    state.clear();
+    chunk.clear();
+    grid.clear();
+}
+void WorldEntities::reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    w.reserve(count);
+    h.reserve(count);
+    archetype.reserve(count);
+    state.reserve(count);
+    chunk.reserve(count);
+}
+int WorldEntities::removeChunk(int id) {
+    // Slide the survivors down over the removed ones, then index them again; unloading is rare next to querying
+    int kept = 0;
+    int count = size();
+    for (int i = 0; i < count; ++i) {
+        if (chunk[i] == id) continue;
+        x[kept] = x[i];
+        y[kept] = y[i];
+        w[kept] = w[i];
+        h[kept] = h[i];
+        archetype[kept] = archetype[i];
+        state[kept] = state[i];
+        chunk[kept] = chunk[i];
+        kept++;
+    }
+    if (kept == count) return 0;
+
+    x.resize(kept);
+    y.resize(kept);
+    w.resize(kept);
+    h.resize(kept);
+    archetype.resize(kept);
+    state.resize(kept);
+    chunk.resize(kept);
+
+    grid.clear();
+    for (int i = 0; i < kept; ++i) grid.insert(i, x[i], y[i], w[i], h[i]);
+    return count - kept;
+}
+void WorldEntities::parsePlacements(std::string_view text, std::vector<EntityPlacement>& out, std::vector<ParseDiagnostic>& diagnostics) {
+    out.reserve(out.size() + countBlocks(text, "\n"));
+
+    TextScanner scanner(text);
+    std::vector<TextLine> lines;
+    while (scanner.nextBlock("----------", lines)) { // Dashed lines may split a level into sections, they mean nothing
+        for (const TextLine& line : lines) {
+            std::string_view rest = line.text.substr(0, line.text.find('#'));
+
+            // Up to five whitespace separated numbers
+            std::string_view fields[5];
+            int count = 0;
+            bool tooMany = false;
+            for (rest = trimLeftView(rest, " \t\r"); !rest.empty(); rest = trimLeftView(rest, " \t\r")) {
+                size_t end = std::min(rest.find_first_of(" \t\r"), rest.size());
+                if (count == 5) {
+                    tooMany = true;
+                    break;
+                }
+                fields[count++] = rest.substr(0, end);
+                rest.remove_prefix(end);
+            }
+            if (count == 0) continue; // Comment or blank
+
+            if (tooMany || (count != 3 && count != 5)) {
+                diagnostics.push_back({ line.number, 1, "expected 'ID X Y' or 'ID X Y W H'" });
+                continue;
+            }
+
+            int values[5] = { 0, 0, 0, DefaultSize, DefaultSize };
+            bool ok = true;
+            for (int i = 0; i < count; ++i) ok = parseInt(line, fields[i], values[i], diagnostics) && ok;
+            if (!ok) continue;
+
+            if (values[3] <= 0 || values[4] <= 0) {
+                int bad = values[3] <= 0 ? 3 : 4; // Only reachable when W and H were both given
+                diagnostics.push_back({ line.number, columnOf(line, fields[bad]), "size must be positive" });
+                continue;
+            }
+
+            out.push_back({ values[0], values[1], values[2], values[3], values[4] });
+        }
+    }
+}
+void WorldEntities::move(int i, int newX, int newY) {
+    x[i] = newX;
+    y[i] = newY;
+    grid.update(i, newX, newY, w[i], h[i]);
+}
+void WorldEntities::gatherOverlaps(int boxX, int boxY, int boxW, int boxH) const {
+    grid.queryBox(boxX, boxY, boxW, boxH, candidates);
+
+    batchX.clear();
+    batchY.clear();
+    batchW.clear();
+    batchH.clear();
+    for (int i : candidates) {
+        batchX.push_back(x[i]);
+        batchY.push_back(y[i]);
+        batchW.push_back(w[i]);
+        batchH.push_back(h[i]);
+    }
+
+    hits.clear();
+    overlapBoxes(batchX.data(), batchY.data(), batchW.data(), batchH.data(), static_cast<int>(candidates.size()),
+                 boxX, boxY, boxW, boxH, hits);
+    for (int& hit : hits) hit = candidates[hit]; // Batch position back to entity index
+}
+int WorldEntities::findOverlap(int boxX, int boxY, int boxW, int boxH) const {
+    gatherOverlaps(boxX, boxY, boxW, boxH);
+    return hits.empty() ? -1 : *std::min_element(hits.begin(), hits.end());
+}
+void WorldEntities::queryBox(int boxX, int boxY, int boxW, int boxH, std::vector<int>& out) const {
+    gatherOverlaps(boxX, boxY, boxW, boxH);
+    out.assign(hits.begin(), hits.end());
+}
+void WorldEntities::queryRadius(int cx, int cy, int radius, std::vector<int>& out) const {
+    gatherOverlaps(cx - radius, cy - radius, radius * 2 + 1, radius * 2 + 1);
+
+    // Keep the ones whose nearest point to the centre is inside the circle
+    out.clear();
+    long long r2 = static_cast<long long>(radius) * radius;
+    for (int i : hits) {
+        long long dx = cx - std::max(x[i], std::min(cx, x[i] + w[i] - 1));
+        long long dy = cy - std::max(y[i], std::min(cy, y[i] + h[i] - 1));
+        if (dx * dx + dy * dy <= r2) out.push_back(i);
+    }
+}
@@ -0,0 +1,82 @@
+# ifndef WORLDENTITIES_HPP
+# define WORLDENTITIES_HPP
+
+# include <string_view>
+# include <vector>
+# include "TextParser.hpp"
+# include "SpatialHash.hpp"
+
+// NPC instances placed in the world, one column per field so collision and drawing walk flat arrays.
+// An instance is only an index: the archetype ID points at the NPC definition (NPCs.txt) it was placed from.
+// A SpatialHash over the boxes keeps queries proportional to what's nearby rather than to the whole map.
+//
+// Level format, used by the world chunk files (World/chunk_X_Y.txt, see WorldStream.hpp).
+// One instance per line, '#' starts a comment:
+//     ID X Y         32x32 at X, Y
+//     ID X Y W H
+
+// Structures
+enum class EntityState : unsigned char {
+    Idle,
+    InCombat // The player is fighting this one
+};
+
+struct EntityPlacement { // One parsed level line
+    int archetype;
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+// Classes
+class WorldEntities {
+    public:
+        static const int DefaultSize = 32;
+        static const int GridCellSize = 64;
+
+        // Returns the new index. chunk tags it for removeChunk, -1 for instances that are always loaded
+        int add(int archetype, int x, int y, int w = DefaultSize, int h = DefaultSize, int chunk = -1);
+        int removeChunk(int chunk); // Returns how many went; indices after the first removed one change
+        void clear();
+        void reserve(size_t count);
+        int size() const { return static_cast<int>(archetype.size()); }
+
+        static void parsePlacements(std::string_view text, std::vector<EntityPlacement>& out, std::vector<ParseDiagnostic>& diagnostics); // Any thread
+
+        void move(int i, int x, int y);
+
+        // Exact hits, edges touching don't count. Not safe to call from two threads at once
+        int findOverlap(int x, int y, int w, int h) const; // Lowest index overlapping the box, -1 if none
+        void queryBox(int x, int y, int w, int h, std::vector<int>& out) const; // Every index overlapping the box
+        void queryRadius(int cx, int cy, int radius, std::vector<int>& out) const; // Every index with some part within radius
+
+        int getX(int i) const { return x[i]; }
+        int getY(int i) const { return y[i]; }
+        int getW(int i) const { return w[i]; }
+        int getH(int i) const { return h[i]; }
+        int getArchetype(int i) const { return archetype[i]; }
+        EntityState getState(int i) const { return state[i]; }
+        int getChunk(int i) const { return chunk[i]; }
+        void setState(int i, EntityState s) { state[i] = s; }
+        const SpatialHash& getGrid() const { return grid; }
+
+    private:
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<int> w;
+        std::vector<int> h;
+        std::vector<int> archetype;
+        std::vector<EntityState> state;
+        std::vector<int> chunk;
+
+        SpatialHash grid{ GridCellSize };
+        // Query scratch: grid candidates, then their boxes side by side for overlapBoxes
+        mutable std::vector<int> candidates;
+        mutable std::vector<int> hits;
+        mutable std::vector<int> batchX, batchY, batchW, batchH;
+
+        void gatherOverlaps(int x, int y, int w, int h) const; // Leaves the overlapping indices in hits
+};
+
+# endif
@@ -0,0 +1,164 @@
+// Includes
+# include "WorldStream.hpp"
+# include <iostream>
+# include <algorithm>
+# include <cstdlib>
+
+// General Functions
+bool loadWorldInfo(const std::string& path, WorldInfo& info) {
+    std::string buffer;
+    if (!readTextFile(path, buffer)) {
+        std::cerr << "Failed to open world file: " << path << "\n";
+        return false;
+    }
+
+    std::vector<ParseDiagnostic> diagnostics;
+    TextScanner scanner(buffer);
+    std::vector<TextLine> lines;
+    while (scanner.nextBlock("----------", lines)) {
+        for (const TextLine& line : lines) {
+            std::string_view text = trimView(line.text.substr(0, line.text.find('#')));
+            if (text.empty()) continue;
+
+            size_t colon = text.find(':');
+            if (colon == std::string_view::npos) {
+                diagnostics.push_back({ line.number, columnOf(line, text), "expected 'Key: value'" });
+                continue;
+            }
+
+            std::string_view key = trimView(text.substr(0, colon));
+            std::string_view value = text.substr(colon + 1);
+            if (key == "Width") parseInt(line, value, info.width, diagnostics);
+            else if (key == "Height") parseInt(line, value, info.height, diagnostics);
+            else if (key == "ChunkSize") parseInt(line, value, info.chunkSize, diagnostics);
+            else diagnostics.push_back({ line.number, columnOf(line, key), "unknown key '" + std::string(key) + "'" });
+        }
+    }
+
+    if (info.width <= 0 || info.height <= 0 || info.chunkSize <= 0) {
+        diagnostics.push_back({ 1, 1, "Width, Height and ChunkSize must all be positive" });
+    }
+    reportDiagnostics(path, diagnostics);
+    return info.width > 0 && info.height > 0 && info.chunkSize > 0;
+}
+
+// Camera Functions
+void Camera::follow(int targetX, int targetY, const WorldInfo& world) {
+    x = std::max(0, std::min(targetX - w / 2, world.width - w));
+    y = std::max(0, std::min(targetY - h / 2, world.height - h));
+}
+
+// ChunkStreamer Functions
+ChunkStreamer::~ChunkStreamer() { stop(); }
+bool ChunkStreamer::open(const std::string& dir) {
+    stop();
+    directory = dir;
+    info = WorldInfo();
+    if (!loadWorldInfo(directory + "/world.txt", info)) return false;
+
+    stopping = false;
+    worker = std::thread(&ChunkStreamer::workerLoop, this);
+    return true;
+}
+void ChunkStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+
+    loaded.clear();
+    chunks.clear();
+    resident = 0;
+}
+void ChunkStreamer::workerLoop() {
+    for (;;) {
+        int chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            chunk = jobs.front();
+            jobs.pop_front();
+        }
+
+        Loaded result;
+        result.chunk = chunk;
+        result.path = directory + "/chunk_" + std::to_string(chunk % info.chunksX()) + "_" + std::to_string(chunk / info.chunksX()) + ".txt";
+        std::string buffer;
+        if (readTextFile(result.path, buffer)) WorldEntities::parsePlacements(buffer, result.placements, result.diagnostics);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return;
+        loaded.push_back(std::move(result));
+    }
+}
+void ChunkStreamer::update(const Camera& view, WorldEntities& world) {
+    if (!worker.joinable()) return;
+
+    auto chunkRange = [&](int margin, int& minX, int& minY, int& maxX, int& maxY) {
+        minX = std::max(0, view.x / info.chunkSize - margin);
+        minY = std::max(0, view.y / info.chunkSize - margin);
+        maxX = std::min(info.chunksX() - 1, (view.x + view.w - 1) / info.chunkSize + margin);
+        maxY = std::min(info.chunksY() - 1, (view.y + view.h - 1) / info.chunkSize + margin);
+    };
+
+    // Drop far chunks first, so a chunk that finished loading after it went out of range is thrown away below
+    int minX, minY, maxX, maxY;
+    chunkRange(UnloadMargin, minX, minY, maxX, maxY);
+    std::vector<int> dropped;
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        int cx = it->first % info.chunksX();
+        int cy = it->first / info.chunksX();
+        if (cx >= minX && cx <= maxX && cy >= minY && cy <= maxY) {
+            ++it;
+            continue;
+        }
+        if (it->second) {
+            world.removeChunk(it->first);
+            resident--;
+        } else {
+            dropped.push_back(it->first);
+        }
+        it = chunks.erase(it);
+    }
+
+    // Ask for missing chunks near the view, closest to its centre first
+    chunkRange(LoadMargin, minX, minY, maxX, maxY);
+    int centreX = (view.x + view.w / 2) / info.chunkSize;
+    int centreY = (view.y + view.h / 2) / info.chunkSize;
+    std::vector<int> wanted;
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            if (chunks.emplace(chunkIndex(cx, cy), false).second) wanted.push_back(chunkIndex(cx, cy));
+        }
+    }
+    std::sort(wanted.begin(), wanted.end(), [&](int a, int b) {
+        int da = std::abs(a % info.chunksX() - centreX) + std::abs(a / info.chunksX() - centreY);
+        int db = std::abs(b % info.chunksX() - centreX) + std::abs(b / info.chunksX() - centreY);
+        return da < db;
+    });
+
+    std::deque<Loaded> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int chunk : dropped) jobs.erase(std::remove(jobs.begin(), jobs.end(), chunk), jobs.end());
+        jobs.insert(jobs.end(), wanted.begin(), wanted.end());
+        finished.swap(loaded);
+    }
+    if (!wanted.empty()) wake.notify_one();
+
+    for (Loaded& chunk : finished) {
+        auto it = chunks.find(chunk.chunk);
+        if (it == chunks.end() || it->second) continue; // Went out of range while loading
+
+        reportDiagnostics(chunk.path, chunk.diagnostics);
+        world.reserve(world.size() + chunk.placements.size());
+        for (const EntityPlacement& p : chunk.placements) world.add(p.archetype, p.x, p.y, p.w, p.h, chunk.chunk);
+        it->second = true;
+        resident++;
+    }
+}
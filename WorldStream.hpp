@@ -0,0 +1,90 @@
+# ifndef WORLDSTREAM_HPP
+# define WORLDSTREAM_HPP
+
+# include <string>
+# include <vector>
+# include <deque>
+# include <unordered_map>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include "WorldEntities.hpp"
+
+// A world bigger than the window, cut into square chunks that are read from disk as the camera gets near them.
+// A world is a folder: world.txt gives the size, chunk_X_Y.txt holds chunk (X, Y)'s NPCs in the level format
+// (WorldEntities.hpp) with world pixel positions. Missing chunk files are just empty ground.
+//
+// world.txt:
+//     Width: 4096
+//     Height: 3072
+//     ChunkSize: 1024
+
+// Structures
+struct WorldInfo {
+    int width = 0; // Pixels
+    int height = 0;
+    int chunkSize = 1024;
+
+    int chunksX() const { return (width + chunkSize - 1) / chunkSize; }
+    int chunksY() const { return (height + chunkSize - 1) / chunkSize; }
+};
+
+struct Camera { // The window's view of the world, in world pixels
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+
+    void follow(int targetX, int targetY, const WorldInfo& world); // Centre on the target without showing past the edges
+};
+
+// Classes
+class ChunkStreamer {
+    public:
+        static const int LoadMargin = 1; // Chunks past the view that get loaded
+        static const int UnloadMargin = 2; // and how far away they go again, the gap stops edge flicker
+
+        ChunkStreamer() = default;
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        ~ChunkStreamer();
+
+        bool open(const std::string& directory); // Reads world.txt and starts the loader thread
+        void stop();
+
+        // Main thread, once a frame: asks for chunks near the view, adds the ones that finished loading to world
+        // and drops the ones that are now far away. Entity indices in world change whenever a chunk is dropped
+        void update(const Camera& view, WorldEntities& world);
+
+        const WorldInfo& getInfo() const { return info; }
+        int getResidentCount() const { return resident; }
+        int getPendingCount() const { return static_cast<int>(chunks.size()) - resident; }
+
+    private:
+        struct Loaded {
+            int chunk;
+            std::string path;
+            std::vector<EntityPlacement> placements;
+            std::vector<ParseDiagnostic> diagnostics;
+        };
+
+        int chunkIndex(int cx, int cy) const { return cy * info.chunksX() + cx; }
+        void workerLoop();
+
+        std::string directory;
+        WorldInfo info;
+        std::unordered_map<int, bool> chunks; // Requested chunks, true once resident
+        int resident = 0;
+
+        std::mutex mutex; // Guards jobs, loaded and stopping
+        std::condition_variable wake;
+        std::deque<int> jobs;
+        std::deque<Loaded> loaded;
+        bool stopping = false;
+        std::thread worker; // Chunk files are small, one thread keeps up with any walking speed
+};
+
+// Functions
+bool loadWorldInfo(const std::string& path, WorldInfo& info);
+
+# endif
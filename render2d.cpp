@@ -1,12 +1,15 @@
 #include <iostream>
 #include <string>
 # include <vector>
+# include <cstdio>
+# include <algorithm>
+# include <array>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include "render2d.hpp"
 
-bool Renderer::init(const char* title, int width, int height) {
+bool Renderer::init(const char* title, int width, int height, bool vsync) {
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << "\n";
         return false;
@@ -28,12 +31,41 @@ bool Renderer::init(const char* title, int width, int height) {
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+    if (vsync) flags |= SDL_RENDERER_PRESENTVSYNC;
+    renderer = SDL_CreateRenderer(window, -1, flags);
     if (!renderer) {
         std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << "\n";
         return false;
     }
 
+    return loadResources();
+}
+bool Renderer::initHeadless(int width, int height) {
+    // No video subsystem, window or display: the software renderer draws straight into frameSurface
+    if (SDL_Init(0) != 0) {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+	
+	windowWidth = width;
+	windowHeight = height;
+	
+    frameSurface = SDL_CreateRGBSurfaceWithFormat(0, windowWidth, windowHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!frameSurface) {
+        std::cerr << "SDL_CreateRGBSurfaceWithFormat failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    renderer = SDL_CreateSoftwareRenderer(frameSurface);
+    if (!renderer) {
+        std::cerr << "SDL_CreateSoftwareRenderer failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    return loadResources();
+}
+bool Renderer::loadResources() {
     if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
         std::cerr << "IMG_Init failed: " << IMG_GetError() << "\n";
         return false;
@@ -58,15 +90,45 @@ bool Renderer::init(const char* title, int width, int height) {
 	
 	Backdrop = loadTexture("Assets/Background.jpg");
 	
-	font = TTF_OpenFont("Assets/font.ttf", 20);
+	font = TTF_OpenFont("Assets/font.ttf", TooltipFontSize);
 	fontUI = TTF_OpenFont("Assets/font.ttf", 10);
 	if (!font || !fontUI) {
 		std::cerr << "Failed to load font: " << TTF_GetError() << "\n";
 		return false;
 	}
 	
+	if (!textGlyphs.build(renderer, font) || !uiGlyphs.build(renderer, fontUI)) {
+		return false;
+	}
+	
+	buildSpriteAtlas();
+	buildPlaceholder();
+	streamer.start();
+	
     return true;
 }
+void Renderer::buildSpriteAtlas() {
+	std::vector<AtlasImage> images = {
+		{ atlasKey(AtlasUI, 0), "Assets/Inventory_Slot.png" },
+		{ atlasKey(AtlasUI, 1), "Assets/Player.png" }
+	};
+	
+	auto items = findAtlasImages("Assets/Items", "I-", AtlasItems);
+	auto npcs = findAtlasImages("Assets/NPCs", "NPC-", AtlasNPCs);
+	images.insert(images.end(), items.begin(), items.end());
+	images.insert(images.end(), npcs.begin(), npcs.end());
+	
+	if (!spriteAtlas.build(renderer, images)) {
+		std::cerr << "Sprite atlas failed, drawing from separate textures\n";
+	}
+}
+void Renderer::drawSprite(RenderLayer layer, const AtlasSprite* sprite, SDL_Texture* fallback, const SDL_Rect& dst) {
+	if (sprite) {
+		active->copy(layer, sprite->texture, &sprite->src, dst);
+	} else if (fallback) {
+		active->copy(layer, fallback, nullptr, dst);
+	}
+}
 SDL_Texture* Renderer::loadTexture(const std::string& path) {
     SDL_Texture* tex = IMG_LoadTexture(renderer, path.c_str());
     if (!tex) {
@@ -75,40 +137,55 @@ SDL_Texture* Renderer::loadTexture(const std::string& path) {
     }
     return tex;
 }
+SDL_Texture* Renderer::streamTexture(long long key, const std::string& path) {
+	if (SDL_Texture* tex = streamer.find(key)) return tex;
+	
+	// Shown until a worker has decoded it and present() has uploaded it, nothing at all if the file is bad
+	return streamer.request(key, path) == AssetStreamer::State::Pending ? placeholderTexture : nullptr;
+}
 SDL_Texture* Renderer::getNPCTexture(int id) {
-    if (npcTextures.count(id)) { return npcTextures[id]; }
-
-    std::string path = "Assets/NPCs/NPC-" + std::to_string(id) + ".png";
-    SDL_Texture* tex = loadTexture(path);
-    npcTextures[id] = tex;
-    return tex;
+    return streamTexture(atlasKey(AtlasNPCs, id), "Assets/NPCs/NPC-" + std::to_string(id) + ".png");
 }
 SDL_Texture* Renderer::getItemTexture(int id) {
-    if (itemTextures.count(id)) { return itemTextures[id]; }
-
-    std::string path = "Assets/Items/I-" + std::to_string(id) + ".png";
-    SDL_Texture* tex = loadTexture(path);
-    itemTextures[id] = tex;
-    return tex;
+    return streamTexture(atlasKey(AtlasItems, id), "Assets/Items/I-" + std::to_string(id) + ".png");
+}
+void Renderer::buildPlaceholder() {
+	const int size = 8;
+	Uint32 pixels[size * size];
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			pixels[y * size + x] = ((x / 2 + y / 2) % 2) ? 0xA0606060 : 0xA0909090; // ARGB checker
+		}
+	}
+	
+	placeholderTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+	if (!placeholderTexture) return;
+	SDL_UpdateTexture(placeholderTexture, nullptr, pixels, size * sizeof(Uint32));
+	SDL_SetTextureBlendMode(placeholderTexture, SDL_BLENDMODE_BLEND);
 }
 void Renderer::clear() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    queue.reset(); // Anything recorded before this would be cleared away anyway
 }
 void Renderer::drawPlayer(int x, int y) {
+    PROFILE_SCOPE(ProfilePhase::DrawPlayer);
     SDL_Rect dst{ x, y, 100, 100 };
-    SDL_RenderCopy(renderer, playerTexture, nullptr, &dst);
+    drawSprite(RenderLayer::Actors, spriteAtlas.find(atlasKey(AtlasUI, 1)), playerTexture, dst);
 }
 void Renderer::drawNPC(int x, int y, int id) {
-    SDL_Texture* tex = getNPCTexture(id);
-    if (!tex) return;
+    PROFILE_SCOPE(ProfilePhase::DrawNPC);
+    const AtlasSprite* sprite = spriteAtlas.find(atlasKey(AtlasNPCs, id));
+    SDL_Texture* tex = sprite ? nullptr : getNPCTexture(id);
+    if (!sprite && !tex) return;
 
     SDL_Rect dst{ x, y, 100, 100 };
-    SDL_RenderCopy(renderer, tex, nullptr, &dst);
+    drawSprite(RenderLayer::World, sprite, tex, dst);
 }
 void Renderer::drawItem(int x, int y, int id, int slotSize) {
-    SDL_Texture* tex = getItemTexture(id);
-    if (!tex) return;
+    PROFILE_SCOPE(ProfilePhase::DrawItem);
+    const AtlasSprite* sprite = spriteAtlas.find(atlasKey(AtlasItems, id));
+    SDL_Texture* tex = sprite ? nullptr : getItemTexture(id);
+    if (!sprite && !tex) return;
+    if (tex == placeholderTexture) drewPlaceholder = true;
 	
 	int iconSize = slotSize * 0.7;
 	
@@ -116,133 +193,230 @@ void Renderer::drawItem(int x, int y, int id, int slotSize) {
 	y += (slotSize - iconSize) / 2;
 	
     SDL_Rect dst{ x, y, iconSize, iconSize };
-    SDL_RenderCopy(renderer, tex, nullptr, &dst);
+    drawSprite(RenderLayer::Icons, sprite, tex, dst);
 }
-void Renderer::drawText(std::string text, int x, int y) {
-	if (!font) return;
-	
+void Renderer::drawText(std::string_view text, int x, int y) {
+	PROFILE_SCOPE(ProfilePhase::DrawText);
 	SDL_Color white = {255, 255, 255, 255};
-	
-	SDL_Surface* surf = TTF_RenderText_Blended(fontUI, text.c_str(), white);
-	if (!surf) return;
-	
-	SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-	SDL_FreeSurface(surf);
-	
-	if (!tex) return;
-	
-	int w, h;
-	SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-	
-	SDL_Rect dst{ x, y, w, h };
-	SDL_RenderCopy(renderer, tex, nullptr, &dst);
-	
-	SDL_DestroyTexture(tex);
+	uiGlyphs.draw(*active, RenderLayer::Text, text, x, y, white);
 }
 void Renderer::present() {
+    PROFILE_SCOPE(ProfilePhase::Present);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    frameStats = queue.submit(renderer);
     SDL_RenderPresent(renderer);
+    frameUploads = streamer.upload(renderer, AssetUploadBudgetMs); // Whatever decoded since last frame, drawn from the next one
 }
 void Renderer::shutdown() {
     SDL_DestroyTexture(playerTexture);
+    invalidateRenderTargets();
+    spriteAtlas.destroy();
+    textGlyphs.destroy();
+    uiGlyphs.destroy();
 
-    for (auto& pair : npcTextures) { SDL_DestroyTexture(pair.second); }
-	for (auto& pair : itemTextures) { SDL_DestroyTexture(pair.second); }
+    streamer.stop();
+    SDL_DestroyTexture(placeholderTexture);
 
     SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    if (window) SDL_DestroyWindow(window);
+    SDL_FreeSurface(frameSurface);
 
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
-void Renderer::drawInventory() {
-	if (!slotTexture) return;
-	
+InventoryLayout Renderer::inventoryLayout(int cols, int rows, int armorSlots) const {
 	float uiScale = 0.5f;
 	
 	int base_slotSize = 92;
 	int slotSize = static_cast<int>(base_slotSize * uiScale);
 	
-	int cols = 10;
-	int rows = 3;
-	
 	int totalWidth = (cols + 1) * slotSize;
 	int totalHeight = (rows + 1) * slotSize;
 	
 	int startX = (windowWidth - totalWidth) / 2;
 	int startY = (windowHeight - totalHeight) / 2;
 	
-	for (int r = 0; r < rows; r++) {
-		for (int c = 0; c < cols; c++) {
-			int x = startX + c * slotSize;
-			int y = startY + r * slotSize;
-			drawSlot(x, y, slotSize);
-		}
-	}
-	
-	int weaponX = startX;
-	int weaponY = startY + rows * slotSize;
-	drawSlot(weaponX, weaponY, slotSize);
+	return { cols, rows, armorSlots, slotSize, startX, startY };
+}
+void Renderer::drawInventory(const Inventory& inventory, const InventoryLayout& layout) {
+	PROFILE_SCOPE(ProfilePhase::DrawInventory);
+	if (!slotTexture) return;
+	if (!beginPanel(inventoryPanel, layout.bounds(), inventory.getContentVersion())) return; // Unchanged, already blitted
 	
-	int armorSlots = 4;
-	int armorStartX = startX - slotSize;
-	int armorStartY = startY;
+	for (int i = 0; i < layout.cols * layout.rows; i++) {
+		SDL_Rect slot = layout.generalSlot(i);
+		drawSlot(slot.x, slot.y, layout.slotSize);
+	}
+	SDL_Rect weapon = layout.weaponSlot();
+	drawSlot(weapon.x, weapon.y, layout.slotSize);
+	for (int i = 0; i < layout.armorSlots; i++) {
+		SDL_Rect armor = layout.armorSlot(i);
+		drawSlot(armor.x, armor.y, layout.slotSize);
+	}
 	
-	for (int i = 0; i < armorSlots; i++) {
-		int x = armorStartX;
-		int y = armorStartY + i * slotSize;
-		drawSlot(x, y, slotSize);
+	for (int i = 0; i < layout.cols * layout.rows; i++) {
+		const Item* item = inventory.getItem(i);
+		SDL_Rect slot = layout.generalSlot(i);
+		if (item) drawItem(slot.x, slot.y, item->getItemID(), layout.slotSize);
+	}
+	if (const Item* item = inventory.getEquippedWeapon()) drawItem(weapon.x, weapon.y, item->getItemID(), layout.slotSize);
+	for (int i = 0; i < layout.armorSlots; i++) {
+		const Item* item = inventory.getEquippedArmor(static_cast<ArmorSlotType>(i));
+		SDL_Rect armor = layout.armorSlot(i);
+		if (item) drawItem(armor.x, armor.y, item->getItemID(), layout.slotSize);
 	}
+	
+	endPanel(inventoryPanel);
 }
 void Renderer::drawSlot(int x, int y, int slotSize) {
+	PROFILE_SCOPE(ProfilePhase::DrawSlot);
 	SDL_Rect dst{ x, y, slotSize, slotSize };
-	SDL_RenderCopy(renderer, slotTexture, nullptr, &dst);
+	drawSprite(RenderLayer::Panels, spriteAtlas.find(atlasKey(AtlasUI, 0)), slotTexture, dst);
 }
-void Renderer::drawTooltip(const std::string& name, const std::string& desc, int x, int y) {
-	if (!font) return;
+void Renderer::drawTooltip(int itemID, std::string_view name, std::string_view desc, int x, int y) {
+	PROFILE_SCOPE(ProfilePhase::DrawTooltip);
+	if (!textGlyphs.isReady()) return;
+	
+	long long key = tooltipKey(itemID, TooltipFontSize);
+	const CachedTooltip* cached = tooltips.find(key);
+	if (!cached) cached = composeTooltip(key, name, desc);
+	if (!cached) {
+		paintTooltip(queue, name, desc, x, y); // No render targets, draw it the slow way
+		return;
+	}
 	
-	SDL_Color white = {255, 255, 255, 255};
-	SDL_Color black = {0, 0, 0, 200};
+	SDL_Rect dst{ x, y, cached->w, cached->h };
+	queue.copy(RenderLayer::Tooltips, cached->texture, nullptr, dst);
+}
+void Renderer::invalidateTooltips() {
+	tooltips.clear();
+}
+void Renderer::invalidateRenderTargets() {
+	tooltips.clear();
+	for (RetainedPanel* panel : { &inventoryPanel, &hudPanel }) {
+		SDL_DestroyTexture(panel->texture);
+		panel->texture = nullptr;
+		panel->valid = false;
+	}
+}
+bool Renderer::beginPanel(RetainedPanel& panel, const SDL_Rect& bounds, unsigned long long version) {
+	bool sameBounds = panel.bounds.x == bounds.x && panel.bounds.y == bounds.y && panel.bounds.w == bounds.w && panel.bounds.h == bounds.h;
+	if (panel.valid && sameBounds && panel.version == version) {
+		queue.copy(RenderLayer::Panels, panel.texture, nullptr, bounds);
+		return false;
+	}
 	
-	SDL_Surface* nameSurf = TTF_RenderText_Blended(font, name.c_str(), white);
-	SDL_Surface* descSurf = TTF_RenderText_Blended_Wrapped(font, desc.c_str(), white, 150);
+	panel.bounds = bounds;
+	panel.version = version;
+	panelQueue.reset();
+	drewPlaceholder = false;
+	active = &panelQueue;
+	return true;
+}
+void Renderer::endPanel(RetainedPanel& panel) {
+	active = &queue;
+	panel.valid = composePanel(panel);
+	if (!panel.valid) {
+		queue.append(panelQueue); // No render targets, draw the contents this frame like anything else
+		panelQueue.reset();
+		return;
+	}
 	
-	SDL_Texture* nameTex = SDL_CreateTextureFromSurface(renderer, nameSurf);
-	SDL_Texture* descTex = SDL_CreateTextureFromSurface(renderer, descSurf);
+	queue.copy(RenderLayer::Panels, panel.texture, nullptr, panel.bounds);
+	if (drewPlaceholder) panel.valid = false; // Redraw once the streamed sprite arrives
+}
+bool Renderer::composePanel(RetainedPanel& panel) {
+	if (!SDL_RenderTargetSupported(renderer) || panel.bounds.w <= 0 || panel.bounds.h <= 0) return false;
+	
+	int w = 0, h = 0;
+	if (panel.texture) SDL_QueryTexture(panel.texture, nullptr, nullptr, &w, &h);
+	if (!panel.texture || w != panel.bounds.w || h != panel.bounds.h) {
+		SDL_DestroyTexture(panel.texture);
+		panel.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, panel.bounds.w, panel.bounds.h);
+		if (!panel.texture) return false;
+		
+		// Drawing onto clear pixels leaves colour already multiplied by alpha, so the blit must not multiply again
+		SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+		if (SDL_SetTextureBlendMode(panel.texture, premultiplied) != 0) SDL_SetTextureBlendMode(panel.texture, SDL_BLENDMODE_BLEND);
+	}
 	
-	int w1, h1, w2, h2;
-	SDL_QueryTexture(nameTex, nullptr, nullptr, &w1, &h1);
-	SDL_QueryTexture(descTex, nullptr, nullptr, &w2, &h2);
+	SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+	if (SDL_SetRenderTarget(renderer, panel.texture) != 0) return false;
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+	SDL_RenderClear(renderer);
+	panelQueue.submit(renderer, -panel.bounds.x, -panel.bounds.y);
+	SDL_SetRenderTarget(renderer, previous);
+	return true;
+}
+SDL_Point Renderer::tooltipSize(std::string_view name, std::string_view desc) const {
+	SDL_Point nameSize = textGlyphs.measure(name);
+	SDL_Point descSize = textGlyphs.measure(desc, TooltipWrapWidth);
+	
+	return { std::max(nameSize.x, descSize.x) + TooltipPadding * 2, nameSize.y + descSize.y + TooltipPadding * 3 };
+}
+void Renderer::paintTooltip(RenderQueue& target, std::string_view name, std::string_view desc, int x, int y) {
+	SDL_Color white = {255, 255, 255, 255};
+	SDL_Point box = tooltipSize(name, desc);
+	int nameHeight = textGlyphs.measure(name).y;
 	
-	int padding = 8;
-	int boxW = std::max(w1, w2) + padding * 2;
-	int boxH = h1 + h2 + padding * 3;
+	SDL_Rect bg{ x, y, box.x, box.y };
+	target.fillRect(RenderLayer::Tooltips, bg, { 50, 50, 50, 255 }); // Opaque, the screen never blended the box either
 	
-	SDL_Rect bg{ x, y, boxW, boxH };
-	SDL_SetRenderDrawColor(renderer, 50, 50, 50, 80);
-	SDL_RenderFillRect(renderer, &bg);
+	textGlyphs.draw(target, RenderLayer::TooltipText, name, x + TooltipPadding, y + TooltipPadding, white);
+	textGlyphs.draw(target, RenderLayer::TooltipText, desc, x + TooltipPadding, y + TooltipPadding + nameHeight + 4, white, TooltipWrapWidth);
+}
+const CachedTooltip* Renderer::composeTooltip(long long key, std::string_view name, std::string_view desc) {
+	if (!SDL_RenderTargetSupported(renderer)) return nullptr;
 	
-	SDL_Rect nameDst{ x + padding, y + padding, w1, h1 };
-	SDL_Rect descDst{ x + padding, y + padding + h1 + 4, w2, h2 };
+	SDL_Point box = tooltipSize(name, desc);
+	SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, box.x, box.y);
+	if (!texture) return nullptr;
 	
-	SDL_RenderCopy(renderer, nameTex, nullptr, &nameDst);
-	SDL_RenderCopy(renderer, descTex, nullptr, &descDst);
+	SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+	if (SDL_SetRenderTarget(renderer, texture) != 0) {
+		SDL_DestroyTexture(texture);
+		return nullptr;
+	}
+	RenderQueue compose; // Its own queue, drawn now while the target is bound
+	paintTooltip(compose, name, desc, 0, 0);
+	compose.submit(renderer);
+	SDL_SetRenderTarget(renderer, previous);
 	
-	SDL_FreeSurface(nameSurf);
-	SDL_FreeSurface(descSurf);
-	SDL_DestroyTexture(nameTex);
-	SDL_DestroyTexture(descTex);
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE); // Every pixel is opaque
+	return tooltips.insert(key, { texture, box.x, box.y });
 }
 void Renderer::drawPlayerUI(int level, int xp, int maxHealth, int health, int gold, std::vector<int>& xpThresholds) {
+	PROFILE_SCOPE(ProfilePhase::DrawPlayerUI);
 	float scale = windowHeight / 1080.0f;
 	
 	int panelW = int(300 * scale);
 	int panelH = int(140 * scale);
 	int margin = int(20 * scale);
 	
-	SDL_SetRenderDrawColor(renderer, 50, 50, 50, 80); // UI Background
+	int nextXP = 0;
+	if (level + 1 < xpThresholds.size()) {
+		nextXP = xpThresholds[level + 1];
+	} else {
+		nextXP = xpThresholds[level];
+	}
+	if (nextXP <= 0) nextXP = 1;
+	
+	// Only redrawn when something shown changes
+	std::array<int, 7> values = { level, xp, nextXP, maxHealth, health, gold, windowHeight };
+	if (values != hudValues) {
+		hudValues = values;
+		hudVersion++;
+	}
+	
 	SDL_Rect panel{ margin, margin, panelW, panelH };
-	SDL_RenderFillRect(renderer, &panel);
+	if (!beginPanel(hudPanel, panel, hudVersion)) return;
+	
+	// Opaque, as they always looked on screen, since the panel texture would otherwise really blend them
+	active->fillRect(RenderLayer::Panels, panel, { 50, 50, 50, 255 }); // UI Background
 	
 	int barW = int(220 * scale); // Bar Dimensions
 	int barH = int(20 * scale);
@@ -261,18 +435,9 @@ void Renderer::drawPlayerUI(int level, int xp, int maxHealth, int health, int go
 		barH 
 	};
 	
-	SDL_SetRenderDrawColor(renderer, 80, 0, 0, 80);
-	SDL_RenderFillRect(renderer, &hpBack);
-	SDL_SetRenderDrawColor(renderer, 200, 0, 0, 160);
-	SDL_RenderFillRect(renderer, &hpFront);
+	active->fillRect(RenderLayer::Panels, hpBack, { 80, 0, 0, 255 });
+	active->fillRect(RenderLayer::Panels, hpFront, { 200, 0, 0, 255 });
 	
-	int nextXP = 0;
-	if (level + 1 < xpThresholds.size()) {
-		nextXP = xpThresholds[level + 1];
-	} else {
-		nextXP = xpThresholds[level];
-	}
-	if (nextXP <= 0) nextXP = 1;
 	int xpW = (barW * xp) / nextXP;
 	SDL_Rect xpBack{ 
 		int(margin + 20 * scale), 
@@ -287,24 +452,51 @@ void Renderer::drawPlayerUI(int level, int xp, int maxHealth, int health, int go
 		barH 
 	};
 
-	SDL_SetRenderDrawColor(renderer, 0, 80, 0, 80);
-	SDL_RenderFillRect(renderer, &xpBack);
-	SDL_SetRenderDrawColor(renderer, 0, 200, 0, 160);
-	SDL_RenderFillRect(renderer, &xpFront);
-	
-	drawText("Health: " + std::to_string(health) + "/" + std::to_string(maxHealth),
-			 int(margin + 20 * scale), int(margin + 37 * scale));
-	drawText("XP: " + std::to_string(xp) + "/" + std::to_string(nextXP),
-			 int(margin + 20 * scale), int(margin + 77 * scale));
-	drawText("Level: " + std::to_string(level),
-			 int(margin + 20 * scale + 100 * scale), int(margin + 77 * scale));
-	drawText("Gold: " + std::to_string(gold), int(margin + 20 * scale), int(margin + 102 * scale));
-}
-void Renderer::drawBackdrop() {
-	SDL_Rect background { 0, 0, windowWidth, windowHeight };
-	SDL_RenderCopy(renderer, Backdrop, nullptr, &background);
+	active->fillRect(RenderLayer::Panels, xpBack, { 0, 80, 0, 255 });
+	active->fillRect(RenderLayer::Panels, xpFront, { 0, 200, 0, 255 });
+	
+	char line[64]; // Formatted on the stack
+	snprintf(line, sizeof(line), "Health: %d/%d", health, maxHealth);
+	drawText(line, int(margin + 20 * scale), int(margin + 37 * scale));
+	snprintf(line, sizeof(line), "XP: %d/%d", xp, nextXP);
+	drawText(line, int(margin + 20 * scale), int(margin + 77 * scale));
+	snprintf(line, sizeof(line), "Level: %d", level);
+	drawText(line, int(margin + 20 * scale + 100 * scale), int(margin + 77 * scale));
+	snprintf(line, sizeof(line), "Gold: %d", gold);
+	drawText(line, int(margin + 20 * scale), int(margin + 102 * scale));
+	
+	endPanel(hudPanel);
+}
+void Renderer::drawDebugText(const std::vector<std::string>& lines, int x, int y) {
+	if (!uiGlyphs.isReady()) return;
+	
+	int lineHeight = uiGlyphs.getLineHeight();
+	int width = 0;
+	for (const auto& line : lines) width = std::max(width, uiGlyphs.measure(line).x);
+	
+	SDL_Rect box{ x, y, width + 12, static_cast<int>(lines.size()) * lineHeight + 12 };
+	queue.fillRect(RenderLayer::Debug, box, { 0, 0, 0, 255 });
+	
+	SDL_Color green = { 180, 255, 180, 255 };
+	for (size_t i = 0; i < lines.size(); i++) {
+		uiGlyphs.draw(queue, RenderLayer::DebugText, lines[i], x + 6, y + 6 + static_cast<int>(i) * lineHeight, green);
+	}
+}
+void Renderer::drawBackdrop(int cameraX, int cameraY) {
+	PROFILE_SCOPE(ProfilePhase::DrawBackdrop);
+	if (windowWidth <= 0 || windowHeight <= 0) return;
+	
+	// The world is tiled with window sized copies, only the ones the view touches (four at most) are drawn
+	int firstX = cameraX - ((cameraX % windowWidth) + windowWidth) % windowWidth;
+	int firstY = cameraY - ((cameraY % windowHeight) + windowHeight) % windowHeight;
+	for (int y = firstY; y < cameraY + windowHeight; y += windowHeight) {
+		for (int x = firstX; x < cameraX + windowWidth; x += windowWidth) {
+			SDL_Rect background { x - cameraX, y - cameraY, windowWidth, windowHeight };
+			active->copy(RenderLayer::Backdrop, Backdrop, nullptr, background);
+		}
+	}
 }
 
 // When updating, use the command line below:
-// "C:\Users\dyo596\C++\mingw64\bin\g++.exe" RPG_Main_Body.cpp render2d.cpp RPG_Inventory_System.cpp NPCs.cpp -DSDL_MAIN_HANDLED -IC:/Users/dyo596/C++/SDL2/include -LC:/Users/dyo596/C++/SDL2/lib -lSDL2 -lSDL2_image -lSDL2_ttf -mconsole -Wl,-subsystem,console -o game.exe
+// "C:\Users\dyo596\C++\mingw64\bin\g++.exe" RPG_Main_Body.cpp render2d.cpp RPG_Inventory_System.cpp NPCs.cpp Combat.cpp GameData.cpp TextParser.cpp ContentPack.cpp HotReload.cpp RectPacker.cpp TextureAtlas.cpp GlyphAtlas.cpp TooltipCache.cpp AssetStreamer.cpp RenderQueue.cpp GameClock.cpp Profiler.cpp WorldEntities.cpp SpatialHash.cpp WorldStream.cpp AudioMixer.cpp JobSystem.cpp -DSDL_MAIN_HANDLED -IC:/Users/dyo596/C++/SDL2/include -LC:/Users/dyo596/C++/SDL2/lib -lSDL2 -lSDL2_image -lSDL2_ttf -mconsole -Wl,-subsystem,console -o game.exe
 // At least until back on your laptop!
\ No newline at end of file
@@ -1,28 +1,59 @@
 # ifndef render2d_HPP
 # define render2d_HPP
 # include <string>
+# include <string_view>
 # include <vector>
-# include <unordered_map>
+# include <array>
+# include <algorithm>
 # include <SDL2/SDL.h>
 # include <SDL2/SDL_image.h>
 # include <SDL2/SDL_ttf.h>
+# include "TextureAtlas.hpp"
+# include "GlyphAtlas.hpp"
+# include "TooltipCache.hpp"
+# include "AssetStreamer.hpp"
+# include "RenderQueue.hpp"
+# include "RPG_Inventory_System.hpp"
+# include "Profiler.hpp"
 
 // Classes and Structures
+struct InventoryLayout { // Where every slot sits on screen, shared by drawing and mouse hit tests
+    int cols;
+    int rows;
+    int armorSlots;
+    int slotSize;
+    int startX;
+    int startY;
+    
+    SDL_Rect generalSlot(int index) const { return { startX + (index % cols) * slotSize, startY + (index / cols) * slotSize, slotSize, slotSize }; }
+    SDL_Rect weaponSlot() const { return { startX, startY + rows * slotSize, slotSize, slotSize }; }
+    SDL_Rect armorSlot(int index) const { return { startX - slotSize, startY + index * slotSize, slotSize, slotSize }; }
+    SDL_Rect bounds() const { return { startX - slotSize, startY, (cols + 1) * slotSize, std::max(rows + 1, armorSlots) * slotSize }; }
+};
+
 class Renderer {
     public:
-        bool init(const char* title, int width, int height);
+        bool init(const char* title, int width, int height, bool vsync = false);
+        bool initHeadless(int width, int height); // Offscreen, into a fixed size software surface, for benchmarks and image tests
         void clear();
         void drawPlayer(int x, int y);
         void drawNPC(int x, int y, int id);
         void drawItem(int x, int y, int id, int slotSize);
-		void drawText(std::string text, int x, int y);
-        void present();
+		void drawText(std::string_view text, int x, int y);
+        void present(); // Submits everything drawn since clear()
         void shutdown();
-		void drawInventory();
-		void drawBackdrop();
+		InventoryLayout inventoryLayout(int cols, int rows, int armorSlots) const;
+		void drawInventory(const Inventory& inventory, const InventoryLayout& layout); // Kept in a texture, redrawn when the contents change
+		void drawBackdrop(int cameraX = 0, int cameraY = 0); // Camera in world pixels, the backdrop repeats across the world
 		void drawSlot(int x, int y, int slotSize);
-		void drawTooltip(const std::string& name, const std::string& desc, int x, int y);
-		void drawPlayerUI(int level, int xp, int maxHealth, int health, int gold, std::vector<int>& xpThresholds);
+		void drawTooltip(int itemID, std::string_view name, std::string_view desc, int x, int y); // Composed once per item, then a single copy
+		void invalidateTooltips(); // After content reloads
+		void invalidateRenderTargets(); // Tooltips and panels, after SDL reports lost render targets
+		void drawPlayerUI(int level, int xp, int maxHealth, int health, int gold, std::vector<int>& xpThresholds); // Kept in a texture, redrawn when a value changes
+		const RenderStats& getFrameStats() const { return frameStats; } // Last presented frame
+		int getFrameUploads() const { return frameUploads; } // Streamed textures created in the last present
+		void drawDebugText(const std::vector<std::string>& lines, int x, int y); // Dark box with lines of small text, over everything
+		SDL_Surface* getFrameSurface() const { return frameSurface; } // Headless only, holds the last presented frame (ARGB8888)
         
 		int windowWidth;
 		int windowHeight;
@@ -30,19 +61,59 @@ class Renderer {
 		TTF_Font* fontUI = nullptr;
 		
     private:
+        enum AtlasGroup { AtlasUI, AtlasItems, AtlasNPCs };
+        
+        struct RetainedPanel { // Screen region drawn once into its own texture and blitted until its version changes
+            SDL_Texture* texture = nullptr;
+            SDL_Rect bounds{ 0, 0, 0, 0 };
+            unsigned long long version = 0;
+            bool valid = false;
+        };
+        
+        static const int TooltipFontSize = 20; // font
+        static const int TooltipWrapWidth = 150;
+        static const int TooltipPadding = 8;
+        static constexpr double AssetUploadBudgetMs = 2.0; // Per frame, for streamed sprites
+        
+        bool loadResources(); // Everything after the renderer exists, shared by both inits
+        void buildSpriteAtlas();
+        void buildPlaceholder();
+        void drawSprite(RenderLayer layer, const AtlasSprite* sprite, SDL_Texture* fallback, const SDL_Rect& dst);
         SDL_Texture* loadTexture(const std::string& path);
+        SDL_Texture* streamTexture(long long key, const std::string& path);
         SDL_Texture* getNPCTexture(int id);
         SDL_Texture* getItemTexture(int id);
+        SDL_Point tooltipSize(std::string_view name, std::string_view desc) const;
+        void paintTooltip(RenderQueue& target, std::string_view name, std::string_view desc, int x, int y);
+        const CachedTooltip* composeTooltip(long long key, std::string_view name, std::string_view desc);
+        bool beginPanel(RetainedPanel& panel, const SDL_Rect& bounds, unsigned long long version); // False means the cached copy was drawn, skip to the end
+        void endPanel(RetainedPanel& panel);
+        bool composePanel(RetainedPanel& panel);
         
         SDL_Window* window = nullptr;
         SDL_Renderer* renderer = nullptr;
+        SDL_Surface* frameSurface = nullptr; // Headless target, window stays null
+        RenderQueue queue; // This frame's draws, submitted in present()
+        RenderQueue panelQueue; // A stale panel's contents between beginPanel and endPanel
+        RenderQueue* active = &queue; // Where draw calls record
+        RenderStats frameStats;
+        int frameUploads = 0;
         
         SDL_Texture* playerTexture = nullptr;
 		SDL_Texture* slotTexture = nullptr;
 		SDL_Texture* Backdrop = nullptr;
         
-        std::unordered_map<int, SDL_Texture*> npcTextures;
-        std::unordered_map<int, SDL_Texture*> itemTextures;
+        GlyphAtlas textGlyphs; // font
+        GlyphAtlas uiGlyphs; // fontUI
+        TextureAtlas spriteAtlas; // Slot, player, item and NPC sprites, so the inventory draws from one texture
+        AssetStreamer streamer; // Only for sprites that didn't make it into the atlas, keyed by atlasKey
+        SDL_Texture* placeholderTexture = nullptr;
+        TooltipCache tooltips; // Keyed by tooltipKey(ItemID, TooltipFontSize)
+        RetainedPanel inventoryPanel; // Versioned by Inventory::getContentVersion
+        RetainedPanel hudPanel;
+        std::array<int, 7> hudValues{}; // What hudPanel currently shows
+        unsigned long long hudVersion = 0;
+        bool drewPlaceholder = false; // A streamed sprite wasn't ready while drawing a panel
 };
 
 # endif
\ No newline at end of file